@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+#include <zip.h>
+#include <zip/parallel.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// The standard parallel algorithms over zipped columns, and
+// zip::parallel_for_each for comparison, as the number of threads
+// grows: the second argument is the number of threads of the TBB arena
+// (or thread_pool) they run in.
+class Execution_Float_3D : public ::benchmark::Fixture {
+   public:
+    void SetUp(::benchmark::State& state) {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        x.resize(size);
+        y.resize(size);
+        out.resize(size);
+        std::iota(x.begin(), x.end(), 0.f);
+        std::iota(y.begin(), y.end(), 1.f);
+        state.counters["threads"] = static_cast<double>(state.range(1));
+    }
+
+    void TearDown(::benchmark::State& state) {
+        state.SetBytesProcessed(state.iterations() * state.range(0) *
+                                static_cast<int64_t>(sizeof(float) * 3));
+    }
+
+    static void Arguments(benchmark::internal::Benchmark* b) {
+        const auto cores = static_cast<std::int64_t>(
+            std::max(1u, std::thread::hardware_concurrency()));
+        for (auto size : {1 << 16, 1 << 20, 1 << 24}) {
+            for (std::int64_t threads = 1; threads < cores; threads *= 2) {
+                b->Args({size, threads});
+            }
+            b->Args({size, cores});
+        }
+    }
+
+    // Runs f in a TBB arena of as many threads as the benchmark asks.
+    template <typename Function>
+    static void run(const ::benchmark::State& state, Function&& f) {
+        const auto threads = static_cast<int>(state.range(1));
+        tbb::global_control limit{tbb::global_control::max_allowed_parallelism,
+                                  static_cast<std::size_t>(threads)};
+        tbb::task_arena arena{threads};
+        arena.execute(std::forward<Function>(f));
+    }
+
+    std::vector<float> x, y, out;
+};
+
+BENCHMARK_DEFINE_F(Execution_Float_3D, ForEachSeq)(benchmark::State& state) {
+    auto z = zip::zip(x, y, out);
+    for (auto _ : state) {
+        std::for_each(std::execution::seq, z.begin(), z.end(), [](auto&& row) {
+            auto&& [a, b, o] = row;
+            o = a * b + 1.f;
+        });
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(Execution_Float_3D, ForEachSeq)
+    ->Args({1 << 16, 1})
+    ->Args({1 << 20, 1})
+    ->Args({1 << 24, 1});
+
+BENCHMARK_DEFINE_F(Execution_Float_3D, ForEachParUnseq)(benchmark::State& state) {
+    auto z = zip::zip(x, y, out);
+    run(state, [&] {
+        for (auto _ : state) {
+            std::for_each(std::execution::par_unseq, z.begin(), z.end(), [](auto&& row) {
+                auto&& [a, b, o] = row;
+                o = a * b + 1.f;
+            });
+            benchmark::DoNotOptimize(out.data());
+        }
+    });
+}
+BENCHMARK_REGISTER_F(Execution_Float_3D, ForEachParUnseq)
+    ->Apply(Execution_Float_3D::Arguments)
+    ->UseRealTime();
+
+BENCHMARK_DEFINE_F(Execution_Float_3D, TransformReduceParUnseq)
+(benchmark::State& state) {
+    auto z = zip::zip(x, y, out);
+    run(state, [&] {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(std::transform_reduce(
+                std::execution::par_unseq, z.begin(), z.end(), 0.f, std::plus{},
+                [](auto&& row) {
+                    auto&& [a, b, o] = row;
+                    return a * b - o;
+                }));
+        }
+    });
+}
+BENCHMARK_REGISTER_F(Execution_Float_3D, TransformReduceParUnseq)
+    ->Apply(Execution_Float_3D::Arguments)
+    ->UseRealTime();
+
+BENCHMARK_DEFINE_F(Execution_Float_3D, ThreadPool)(benchmark::State& state) {
+    zip::thread_pool pool{static_cast<std::size_t>(state.range(1) - 1)};
+    for (auto _ : state) {
+        zip::parallel_for_each(pool, zip::zip(x, y, out), [](auto&& row) {
+            auto&& [a, b, o] = row;
+            o = a * b + 1.f;
+        });
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(Execution_Float_3D, ThreadPool)
+    ->Apply(Execution_Float_3D::Arguments)
+    ->UseRealTime();
@@ -1,11 +1,23 @@
 #include <benchmark/benchmark.h>
 #include <zip.h>
+#include <zip/algorithm.h>
+#include <zip/aosoa.h>
+#include <zip/expr.h>
+#include <zip/isa.h>
+#include <zip/numeric.h>
+#include <zip/soa_vector.h>
+#include <zip/stream_out.h>
 
 #include <algorithm>
 #include <array>
 #include <numeric>
+#include <random>
+#include <utility>
 #include <vector>
 
+// Lanes per step in batched traversals
+constexpr std::size_t BatchWidth = 8;
+
 template <typename T, std::size_t N>
 class SoA : public ::benchmark::Fixture {
    public:
@@ -28,6 +40,16 @@ class SoA : public ::benchmark::Fixture {
 
     constexpr auto size() const noexcept { return std::size(data[0]); }
 
+    auto batches() const noexcept {
+        return batches_impl(std::make_index_sequence<N>{});
+    }
+
+    template <std::size_t... Indexes>
+    auto batches_impl(std::index_sequence<Indexes...>) const noexcept {
+        return zip::batches<BatchWidth>(
+            zip::zip(zip::offset_iterator_tag{}, data[Indexes]...));
+    }
+
     constexpr auto cbegin() const noexcept {
         return cbegin_impl(std::make_index_sequence<N>{});
     }
@@ -114,6 +136,23 @@ BENCHMARK_DEFINE_F(SoA_Int32_1D, SumZip)(benchmark::State& state) {
 }
 BENCHMARK_REGISTER_F(SoA_Int32_1D, SumZip)->Range(1 << 0, 1 << 10);
 
+BENCHMARK_DEFINE_F(SoA_Int32_1D, SumBatch)(benchmark::State& state) {
+    for (auto _ : state) {
+        auto sum_x = std::array<value_type, BatchWidth>{};
+
+        for (auto&& [lanes_x] : batches()) {
+            for (std::size_t i = 0; i < BatchWidth; ++i) {
+                sum_x[i] += lanes_x[i];
+            }
+        }
+
+        auto return_sum_x =
+            std::accumulate(std::begin(sum_x), std::end(sum_x), value_type{});
+        benchmark::DoNotOptimize(return_sum_x);
+    }
+}
+BENCHMARK_REGISTER_F(SoA_Int32_1D, SumBatch)->Range(1 << 0, 1 << 10);
+
 ///////////////////////////////////////////////////////////////////////////////
 using SoA_Int32_2D = SoA<std::int32_t, 2>;
 ///////////////////////////////////////////////////////////////////////////////
@@ -193,6 +232,28 @@ BENCHMARK_DEFINE_F(SoA_Int32_2D, SumZip)(benchmark::State& state) {
 }
 BENCHMARK_REGISTER_F(SoA_Int32_2D, SumZip)->Range(1 << 0, 1 << 10);
 
+BENCHMARK_DEFINE_F(SoA_Int32_2D, SumBatch)(benchmark::State& state) {
+    for (auto _ : state) {
+        auto sum_x = std::array<value_type, BatchWidth>{};
+        auto sum_y = std::array<value_type, BatchWidth>{};
+
+        for (auto&& [lanes_x, lanes_y] : batches()) {
+            for (std::size_t i = 0; i < BatchWidth; ++i) {
+                sum_x[i] += lanes_x[i];
+                sum_y[i] += lanes_y[i];
+            }
+        }
+
+        auto return_sum_x =
+            std::accumulate(std::begin(sum_x), std::end(sum_x), value_type{});
+        auto return_sum_y =
+            std::accumulate(std::begin(sum_y), std::end(sum_y), value_type{});
+        benchmark::DoNotOptimize(return_sum_x);
+        benchmark::DoNotOptimize(return_sum_y);
+    }
+}
+BENCHMARK_REGISTER_F(SoA_Int32_2D, SumBatch)->Range(1 << 0, 1 << 10);
+
 ///////////////////////////////////////////////////////////////////////////////
 using SoA_Int32_3D = SoA<std::int32_t, 3>;
 ///////////////////////////////////////////////////////////////////////////////
@@ -291,6 +352,33 @@ BENCHMARK_DEFINE_F(SoA_Int32_3D, SumZip)(benchmark::State& state) {
 }
 BENCHMARK_REGISTER_F(SoA_Int32_3D, SumZip)->Range(1 << 0, 1 << 10);
 
+BENCHMARK_DEFINE_F(SoA_Int32_3D, SumBatch)(benchmark::State& state) {
+    for (auto _ : state) {
+        auto sum_x = std::array<value_type, BatchWidth>{};
+        auto sum_y = std::array<value_type, BatchWidth>{};
+        auto sum_z = std::array<value_type, BatchWidth>{};
+
+        for (auto&& [lanes_x, lanes_y, lanes_z] : batches()) {
+            for (std::size_t i = 0; i < BatchWidth; ++i) {
+                sum_x[i] += lanes_x[i];
+                sum_y[i] += lanes_y[i];
+                sum_z[i] += lanes_z[i];
+            }
+        }
+
+        auto return_sum_x =
+            std::accumulate(std::begin(sum_x), std::end(sum_x), value_type{});
+        auto return_sum_y =
+            std::accumulate(std::begin(sum_y), std::end(sum_y), value_type{});
+        auto return_sum_z =
+            std::accumulate(std::begin(sum_z), std::end(sum_z), value_type{});
+        benchmark::DoNotOptimize(return_sum_x);
+        benchmark::DoNotOptimize(return_sum_y);
+        benchmark::DoNotOptimize(return_sum_z);
+    }
+}
+BENCHMARK_REGISTER_F(SoA_Int32_3D, SumBatch)->Range(1 << 0, 1 << 10);
+
 ////////////////////////////////////////////////////////////////////
 
 class AoS_Int32_3D : public ::benchmark::Fixture {};
@@ -327,3 +415,782 @@ BENCHMARK_DEFINE_F(AoS_Int32_3D, SumSubscript)(benchmark::State& state) {
                             static_cast<int64_t>(sizeof(int) * 3));
 }
 BENCHMARK_REGISTER_F(AoS_Int32_3D, SumSubscript)->Range(1 << 0, 1 << 10);
+
+BENCHMARK_DEFINE_F(AoS_Int32_3D, SumFields)(benchmark::State& state) {
+    struct Item {
+        int x;
+        int y;
+        int z;
+    };
+    const auto val = static_cast<int>(state.range(0));
+    const std::vector<Item> v(static_cast<std::size_t>(state.range(0)), {val, val, val});
+
+    for (auto _ : state) {
+        int sum_x = 0;
+        int sum_y = 0;
+        int sum_z = 0;
+
+        for (auto&& [value_x, value_y, value_z] :
+             zip::fields(v, &Item::x, &Item::y, &Item::z)) {
+            sum_x += value_x;
+            sum_y += value_y;
+            sum_z += value_z;
+        }
+
+        int return_sum_x = sum_x;
+        int return_sum_y = sum_y;
+        int return_sum_z = sum_z;
+        benchmark::DoNotOptimize(return_sum_x);
+        benchmark::DoNotOptimize(return_sum_y);
+        benchmark::DoNotOptimize(return_sum_z);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            static_cast<int64_t>(sizeof(int) * 3));
+}
+BENCHMARK_REGISTER_F(AoS_Int32_3D, SumFields)->Range(1 << 0, 1 << 10);
+
+////////////////////////////////////////////////////////////////////
+
+class Append_Int32_3D : public ::benchmark::Fixture {};
+
+BENCHMARK_DEFINE_F(Append_Int32_3D, Vectors)(benchmark::State& state) {
+    const auto size = static_cast<int>(state.range(0));
+
+    for (auto _ : state) {
+        std::vector<int> x;
+        std::vector<int> y;
+        std::vector<int> z;
+
+        for (int i = 0; i < size; ++i) {
+            x.push_back(i);
+            y.push_back(i);
+            z.push_back(i);
+        }
+
+        benchmark::DoNotOptimize(x.data());
+        benchmark::DoNotOptimize(y.data());
+        benchmark::DoNotOptimize(z.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            static_cast<int64_t>(sizeof(int) * 3));
+}
+BENCHMARK_REGISTER_F(Append_Int32_3D, Vectors)->Range(1 << 0, 1 << 10);
+
+BENCHMARK_DEFINE_F(Append_Int32_3D, SoaVector)(benchmark::State& state) {
+    const auto size = static_cast<int>(state.range(0));
+
+    for (auto _ : state) {
+        zip::soa_vector<int, int, int> v;
+
+        for (int i = 0; i < size; ++i) {
+            v.emplace_back(i, i, i);
+        }
+
+        benchmark::DoNotOptimize(v.data<0>());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            static_cast<int64_t>(sizeof(int) * 3));
+}
+BENCHMARK_REGISTER_F(Append_Int32_3D, SoaVector)->Range(1 << 0, 1 << 10);
+
+////////////////////////////////////////////////////////////////////
+
+// One kernel touching all the columns of each row, over SoA, AoS and
+// AoSoA layouts, from L1 resident sizes up to DRAM ones.
+// AoSoA tiles are one cache line wide for each column.
+constexpr std::size_t TileWidth = 16;
+
+class Layout_Int32_3D : public ::benchmark::Fixture {
+   public:
+    void TearDown(::benchmark::State& state) {
+        state.SetBytesProcessed(state.iterations() * state.range(0) *
+                                static_cast<int64_t>(sizeof(std::int32_t) * 3));
+    }
+};
+
+BENCHMARK_DEFINE_F(Layout_Int32_3D, SoA)(benchmark::State& state) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    std::vector<std::int32_t> x(size, 1);
+    std::vector<std::int32_t> y(size, 2);
+    std::vector<std::int32_t> z(size, 3);
+
+    for (auto _ : state) {
+        for (auto&& [value_x, value_y, value_z] : zip::zip(x, y, z)) {
+            value_x = value_y * value_z - value_x;
+        }
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+BENCHMARK_REGISTER_F(Layout_Int32_3D, SoA)->Range(1 << 8, 1 << 22);
+
+BENCHMARK_DEFINE_F(Layout_Int32_3D, AoS)(benchmark::State& state) {
+    struct Item {
+        std::int32_t x;
+        std::int32_t y;
+        std::int32_t z;
+    };
+    std::vector<Item> v(static_cast<std::size_t>(state.range(0)), {1, 2, 3});
+
+    for (auto _ : state) {
+        for (auto&& item : v) {
+            item.x = item.y * item.z - item.x;
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK_REGISTER_F(Layout_Int32_3D, AoS)->Range(1 << 8, 1 << 22);
+
+BENCHMARK_DEFINE_F(Layout_Int32_3D, AoSoA)(benchmark::State& state) {
+    zip::aosoa<TileWidth, std::int32_t, std::int32_t, std::int32_t> v;
+    for (auto i = state.range(0); i > 0; --i) {
+        v.emplace_back(1, 2, 3);
+    }
+
+    for (auto _ : state) {
+        for (auto&& [value_x, value_y, value_z] : v) {
+            value_x = value_y * value_z - value_x;
+        }
+        benchmark::DoNotOptimize(v.tiles().begin());
+    }
+}
+BENCHMARK_REGISTER_F(Layout_Int32_3D, AoSoA)->Range(1 << 8, 1 << 22);
+
+BENCHMARK_DEFINE_F(Layout_Int32_3D, AoSoATiles)(benchmark::State& state) {
+    zip::aosoa<TileWidth, std::int32_t, std::int32_t, std::int32_t> v;
+    for (auto i = state.range(0); i > 0; --i) {
+        v.emplace_back(1, 2, 3);
+    }
+
+    for (auto _ : state) {
+        for (auto&& [lanes_x, lanes_y, lanes_z] : v.tiles()) {
+            for (std::size_t i = 0; i < TileWidth; ++i) {
+                lanes_x[i] = lanes_y[i] * lanes_z[i] - lanes_x[i];
+            }
+        }
+        benchmark::DoNotOptimize(v.tiles().begin());
+    }
+}
+BENCHMARK_REGISTER_F(Layout_Int32_3D, AoSoATiles)->Range(1 << 8, 1 << 22);
+
+////////////////////////////////////////////////////////////////////
+
+class Sort_Int32_Key : public ::benchmark::Fixture {
+   public:
+    void SetUp(const ::benchmark::State& state) {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        std::mt19937 gen{42};
+        input_key.resize(size);
+        std::generate(std::begin(input_key), std::end(input_key), gen);
+        input_payload.resize(size);
+        std::iota(std::begin(input_payload), std::end(input_payload), std::int64_t{0});
+    }
+
+    void TearDown(::benchmark::State& state) {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Columns are restored before each sort, out of the timed region
+    void reset(benchmark::State& state) {
+        state.PauseTiming();
+        key = input_key;
+        payload = input_payload;
+        state.ResumeTiming();
+    }
+
+    std::vector<std::uint32_t> input_key;
+    std::vector<std::int64_t> input_payload;
+    std::vector<std::uint32_t> key;
+    std::vector<std::int64_t> payload;
+};
+
+BENCHMARK_DEFINE_F(Sort_Int32_Key, StdSort)(benchmark::State& state) {
+    for (auto _ : state) {
+        reset(state);
+        auto z = zip::zip(key, payload);
+        std::sort(std::begin(z), std::end(z), [](auto&& lhs, auto&& rhs) {
+            return std::get<0>(lhs) < std::get<0>(rhs);
+        });
+        benchmark::DoNotOptimize(key.data());
+    }
+}
+BENCHMARK_REGISTER_F(Sort_Int32_Key, StdSort)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_DEFINE_F(Sort_Int32_Key, RadixSort)(benchmark::State& state) {
+    for (auto _ : state) {
+        reset(state);
+        zip::radix_sort<0>(zip::zip(key, payload));
+        benchmark::DoNotOptimize(key.data());
+    }
+}
+BENCHMARK_REGISTER_F(Sort_Int32_Key, RadixSort)->Range(1 << 10, 1 << 22)->UseRealTime();
+
+////////////////////////////////////////////////////////////////////
+
+class Transpose_Int32_4D : public ::benchmark::Fixture {
+   public:
+    struct Item {
+        int x;
+        int y;
+        int z;
+        int w;
+    };
+
+    void SetUp(const ::benchmark::State& state) {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        aos.resize(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto val = static_cast<int>(i);
+            aos[i] = {val, val + 1, val + 2, val + 3};
+        }
+        x.resize(size);
+        y.resize(size);
+        z.resize(size);
+        w.resize(size);
+    }
+
+    void TearDown(::benchmark::State& state) {
+        state.SetBytesProcessed(state.iterations() * state.range(0) *
+                                static_cast<int64_t>(sizeof(Item)));
+    }
+
+    auto fields() { return zip::fields<&Item::x, &Item::y, &Item::z, &Item::w>(aos); }
+
+    auto columns() { return zip::zip(x, y, z, w); }
+
+    std::vector<Item> aos;
+    std::vector<int> x;
+    std::vector<int> y;
+    std::vector<int> z;
+    std::vector<int> w;
+};
+
+BENCHMARK_DEFINE_F(Transpose_Int32_4D, ScatterNaive)(benchmark::State& state) {
+    for (auto _ : state) {
+        for (auto&& [item, value_x, value_y, value_z, value_w] : zip::zip(aos, x, y, z, w)) {
+            value_x = item.x;
+            value_y = item.y;
+            value_z = item.z;
+            value_w = item.w;
+        }
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+BENCHMARK_REGISTER_F(Transpose_Int32_4D, ScatterNaive)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_DEFINE_F(Transpose_Int32_4D, ScatterToColumns)(benchmark::State& state) {
+    for (auto _ : state) {
+        zip::scatter_to_columns(fields(), columns());
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+BENCHMARK_REGISTER_F(Transpose_Int32_4D, ScatterToColumns)
+    ->Range(1 << 10, 1 << 20)
+    ->UseRealTime();
+
+BENCHMARK_DEFINE_F(Transpose_Int32_4D, GatherNaive)(benchmark::State& state) {
+    for (auto _ : state) {
+        for (auto&& [item, value_x, value_y, value_z, value_w] : zip::zip(aos, x, y, z, w)) {
+            item = {value_x, value_y, value_z, value_w};
+        }
+        benchmark::DoNotOptimize(aos.data());
+    }
+}
+BENCHMARK_REGISTER_F(Transpose_Int32_4D, GatherNaive)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_DEFINE_F(Transpose_Int32_4D, GatherFromColumns)(benchmark::State& state) {
+    for (auto _ : state) {
+        zip::gather_from_columns(columns(), fields());
+        benchmark::DoNotOptimize(aos.data());
+    }
+}
+BENCHMARK_REGISTER_F(Transpose_Int32_4D, GatherFromColumns)
+    ->Range(1 << 10, 1 << 20)
+    ->UseRealTime();
+
+////////////////////////////////////////////////////////////////////
+
+// A chain of element-wise stages, evaluated one std::transform at a
+// time through temporary columns, or fused into a single expression.
+class Fused_Float_3D : public ::benchmark::Fixture {
+   public:
+    void SetUp(const ::benchmark::State& state) {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        x.assign(size, 1.5f);
+        y.assign(size, -2.0f);
+        z.assign(size, 0.5f);
+        out.resize(size);
+    }
+
+    void TearDown(::benchmark::State& state) {
+        state.SetBytesProcessed(state.iterations() * state.range(0) *
+                                static_cast<int64_t>(sizeof(float) * 4));
+    }
+
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> out;
+};
+
+BENCHMARK_DEFINE_F(Fused_Float_3D, TransformChain)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<float> tmp(x.size());
+        std::transform(x.begin(), x.end(), y.begin(), tmp.begin(),
+                       [](float a, float b) { return a * b; });
+        std::transform(tmp.begin(), tmp.end(), z.begin(), tmp.begin(),
+                       [](float a, float b) { return a + b; });
+        std::transform(tmp.begin(), tmp.end(), out.begin(),
+                       [](float v) { return v < 0 ? -v : v; });
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(Fused_Float_3D, TransformChain)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_DEFINE_F(Fused_Float_3D, Expr)(benchmark::State& state) {
+    for (auto _ : state) {
+        zip::assign(out, zip::expr(x, y, z)([](float a, float b, float c) {
+                             return a * b + c;
+                         })([](float v) { return v < 0 ? -v : v; }));
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(Fused_Float_3D, Expr)->Range(1 << 10, 1 << 22);
+
+////////////////////////////////////////////////////////////////////
+
+// Filtering rows on a random key, for selectivities from 1% to 99%:
+// the argument is the percentage of rows kept.
+class Filter_Int32_3D : public ::benchmark::Fixture {
+   public:
+    static constexpr std::size_t Size = 1 << 20;
+
+    void SetUp(const ::benchmark::State&) {
+        std::mt19937 gen{42};
+        std::uniform_int_distribution<std::int32_t> dist{0, 99};
+        key.resize(Size);
+        std::generate(key.begin(), key.end(), [&] { return dist(gen); });
+        y.assign(Size, 2);
+        z.assign(Size, 3);
+        out_key.resize(Size);
+        out_y.resize(Size);
+        out_z.resize(Size);
+    }
+
+    void TearDown(::benchmark::State& state) {
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Size));
+    }
+
+    std::vector<std::int32_t> key;
+    std::vector<std::int32_t> y;
+    std::vector<std::int32_t> z;
+    std::vector<std::int32_t> out_key;
+    std::vector<std::int32_t> out_y;
+    std::vector<std::int32_t> out_z;
+};
+
+BENCHMARK_DEFINE_F(Filter_Int32_3D, StdCopyIf)(benchmark::State& state) {
+    const auto threshold = static_cast<std::int32_t>(state.range(0));
+    auto in = zip::zip(key, y, z);
+    auto out = zip::zip(out_key, out_y, out_z);
+    for (auto _ : state) {
+        auto last = std::copy_if(in.begin(), in.end(), out.begin(),
+                                 [threshold](auto&& row) {
+                                     return std::get<0>(row) < threshold;
+                                 });
+        benchmark::DoNotOptimize(last);
+    }
+}
+BENCHMARK_REGISTER_F(Filter_Int32_3D, StdCopyIf)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(90)
+    ->Arg(99);
+
+BENCHMARK_DEFINE_F(Filter_Int32_3D, FilterCopy)(benchmark::State& state) {
+    const auto threshold = static_cast<std::int32_t>(state.range(0));
+    for (auto _ : state) {
+        auto count = zip::filter_copy(
+            zip::zip(key, y, z),
+            [threshold](auto&& row) { return std::get<0>(row) < threshold; },
+            zip::zip(out_key, out_y, out_z));
+        benchmark::DoNotOptimize(count);
+    }
+}
+BENCHMARK_REGISTER_F(Filter_Int32_3D, FilterCopy)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(90)
+    ->Arg(99);
+
+////////////////////////////////////////////////////////////////////
+
+// Reordering four columns by a random permutation, from cache
+// resident sizes up to DRAM ones.
+class Gather_Int32_4D : public ::benchmark::Fixture {
+   public:
+    void SetUp(const ::benchmark::State& state) {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        for (auto* column : {&x, &y, &z, &w, &out_x, &out_y, &out_z, &out_w}) {
+            column->resize(size);
+            std::iota(column->begin(), column->end(), 0);
+        }
+        perm.resize(size);
+        std::iota(perm.begin(), perm.end(), 0u);
+        std::shuffle(perm.begin(), perm.end(), std::mt19937{42});
+    }
+
+    void TearDown(::benchmark::State& state) {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    std::vector<std::int32_t> x, y, z, w;
+    std::vector<std::int32_t> out_x, out_y, out_z, out_w;
+    std::vector<std::uint32_t> perm;
+};
+
+BENCHMARK_DEFINE_F(Gather_Int32_4D, ColumnLoops)(benchmark::State& state) {
+    for (auto _ : state) {
+        const auto size = perm.size();
+        for (std::size_t i = 0; i < size; ++i) {
+            out_x[i] = x[perm[i]];
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            out_y[i] = y[perm[i]];
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            out_z[i] = z[perm[i]];
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            out_w[i] = w[perm[i]];
+        }
+        benchmark::DoNotOptimize(out_x.data());
+    }
+}
+BENCHMARK_REGISTER_F(Gather_Int32_4D, ColumnLoops)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_DEFINE_F(Gather_Int32_4D, Gather)(benchmark::State& state) {
+    for (auto _ : state) {
+        zip::gather(zip::zip(x, y, z, w), perm, zip::zip(out_x, out_y, out_z, out_w));
+        benchmark::DoNotOptimize(out_x.data());
+    }
+}
+BENCHMARK_REGISTER_F(Gather_Int32_4D, Gather)->Range(1 << 10, 1 << 22)->UseRealTime();
+
+////////////////////////////////////////////////////////////////////
+
+// A column read through an index indirection: element i is
+// table[index[i]].
+class indirect_iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::int32_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const std::int32_t&;
+    using pointer = const std::int32_t*;
+
+    indirect_iterator(const std::int32_t* table, const std::uint32_t* index)
+        : m_table{table}, m_index{index} {}
+
+    reference operator*() const { return m_table[*m_index]; }
+    reference operator[](difference_type n) const { return m_table[m_index[n]]; }
+
+    indirect_iterator& operator++() {
+        ++m_index;
+        return *this;
+    }
+    indirect_iterator& operator--() {
+        --m_index;
+        return *this;
+    }
+    indirect_iterator& operator+=(difference_type n) {
+        m_index += n;
+        return *this;
+    }
+    indirect_iterator& operator-=(difference_type n) {
+        m_index -= n;
+        return *this;
+    }
+    indirect_iterator operator+(difference_type n) const {
+        return {m_table, m_index + n};
+    }
+    indirect_iterator operator-(difference_type n) const {
+        return {m_table, m_index - n};
+    }
+    difference_type operator-(const indirect_iterator& rhs) const {
+        return m_index - rhs.m_index;
+    }
+    bool operator==(const indirect_iterator& rhs) const { return m_index == rhs.m_index; }
+    bool operator!=(const indirect_iterator& rhs) const { return m_index != rhs.m_index; }
+    bool operator<(const indirect_iterator& rhs) const { return m_index < rhs.m_index; }
+
+   private:
+    const std::int32_t* m_table;
+    const std::uint32_t* m_index;
+};
+
+// Joining a column to a table through random indexes, from sizes
+// fitting in the last level cache up to DRAM ones, at several
+// prefetch distances: 0 prefetches nothing.
+class Prefetch_Int32_Indirect : public ::benchmark::Fixture {
+   public:
+    void SetUp(const ::benchmark::State& state) {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        keys.resize(size);
+        table.resize(size);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::iota(table.begin(), table.end(), 0);
+        index.resize(size);
+        std::iota(index.begin(), index.end(), 0u);
+        std::shuffle(index.begin(), index.end(), std::mt19937{42});
+    }
+
+    void TearDown(::benchmark::State& state) {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <std::size_t Distance>
+    void run(benchmark::State& state) {
+        auto values = zip::slice<indirect_iterator>{
+            {table.data(), index.data()},
+            {table.data(), index.data() + static_cast<std::ptrdiff_t>(index.size())}};
+        auto rows = zip::prefetched<Distance>(zip::zip(keys, values));
+        for (auto _ : state) {
+            std::int64_t sum = 0;
+            for (auto&& [key, value] : rows) {
+                sum += std::int64_t{key} * value;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+    }
+
+    std::vector<std::int32_t> keys;
+    std::vector<std::int32_t> table;
+    std::vector<std::uint32_t> index;
+};
+
+BENCHMARK_DEFINE_F(Prefetch_Int32_Indirect, Distance0)(benchmark::State& state) {
+    run<0>(state);
+}
+BENCHMARK_REGISTER_F(Prefetch_Int32_Indirect, Distance0)->Range(1 << 16, 1 << 24);
+
+BENCHMARK_DEFINE_F(Prefetch_Int32_Indirect, Distance4)(benchmark::State& state) {
+    run<4>(state);
+}
+BENCHMARK_REGISTER_F(Prefetch_Int32_Indirect, Distance4)->Range(1 << 16, 1 << 24);
+
+BENCHMARK_DEFINE_F(Prefetch_Int32_Indirect, Distance16)(benchmark::State& state) {
+    run<16>(state);
+}
+BENCHMARK_REGISTER_F(Prefetch_Int32_Indirect, Distance16)->Range(1 << 16, 1 << 24);
+
+BENCHMARK_DEFINE_F(Prefetch_Int32_Indirect, Distance64)(benchmark::State& state) {
+    run<64>(state);
+}
+BENCHMARK_REGISTER_F(Prefetch_Int32_Indirect, Distance64)->Range(1 << 16, 1 << 24);
+
+////////////////////////////////////////////////////////////////////
+
+// Materialising three result columns from two inputs, through the
+// caches or streamed to memory with non-temporal stores.
+class Materialise_Float_3D : public ::benchmark::Fixture {
+   public:
+    void SetUp(const ::benchmark::State& state) {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        x.assign(size, 1.5f);
+        y.assign(size, -2.0f);
+        sum.resize(size);
+        diff.resize(size);
+        product.resize(size);
+    }
+
+    void TearDown(::benchmark::State& state) {
+        state.SetBytesProcessed(state.iterations() * state.range(0) *
+                                static_cast<int64_t>(sizeof(float) * 5));
+    }
+
+    auto results() const {
+        return zip::expr(x, y)(
+            [](float a, float b) { return std::tuple{a + b, a - b, a * b}; });
+    }
+
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> sum;
+    std::vector<float> diff;
+    std::vector<float> product;
+};
+
+BENCHMARK_DEFINE_F(Materialise_Float_3D, Assign)(benchmark::State& state) {
+    for (auto _ : state) {
+        zip::assign(zip::zip(sum, diff, product), results());
+        benchmark::DoNotOptimize(sum.data());
+    }
+}
+BENCHMARK_REGISTER_F(Materialise_Float_3D, Assign)->Range(1 << 16, 1 << 26);
+
+BENCHMARK_DEFINE_F(Materialise_Float_3D, StreamOut)(benchmark::State& state) {
+    for (auto _ : state) {
+        zip::assign(zip::stream_out(sum, diff, product), results());
+        benchmark::DoNotOptimize(sum.data());
+    }
+}
+BENCHMARK_REGISTER_F(Materialise_Float_3D, StreamOut)->Range(1 << 16, 1 << 26);
+
+////////////////////////////////////////////////////////////////////
+
+// Kernels over columns misaligned by different amounts, as they come
+// out of different allocators, through a plain zipped loop or the
+// alignment-peeling zip::for_each.
+class Misaligned_Int32_3D : public ::benchmark::Fixture {
+   public:
+    void SetUp(const ::benchmark::State& state) {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        for (auto* column : {&x_data, &y_data, &z_data}) {
+            column->assign(size + 16, 1);
+        }
+        x = {x_data.data() + 1, x_data.data() + 1 + size};
+        y = {y_data.data() + 2, y_data.data() + 2 + size};
+        z = {z_data.data() + 3, z_data.data() + 3 + size};
+    }
+
+    void TearDown(::benchmark::State& state) {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    std::vector<std::int32_t> x_data, y_data, z_data;
+    zip::slice<std::int32_t*> x, y, z;
+};
+
+BENCHMARK_DEFINE_F(Misaligned_Int32_3D, SumZip)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::int32_t sum = 0;
+        auto view = zip::zip(x, y, z);
+        for (auto it = std::begin(view); it != std::end(view); ++it) {
+            const auto [a, b, c] = *it;
+            sum += a + b + c;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK_REGISTER_F(Misaligned_Int32_3D, SumZip)->Range(1 << 10, 1 << 16);
+
+BENCHMARK_DEFINE_F(Misaligned_Int32_3D, SumForEach)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::int32_t sum = 0;
+        zip::for_each(zip::zip(x, y, z), [&sum](auto&& row) {
+            const auto [a, b, c] = row;
+            sum += a + b + c;
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK_REGISTER_F(Misaligned_Int32_3D, SumForEach)->Range(1 << 10, 1 << 16);
+
+BENCHMARK_DEFINE_F(Misaligned_Int32_3D, AxpyZip)(benchmark::State& state) {
+    for (auto _ : state) {
+        for (auto&& [a, b, c] : zip::zip(x, y, z)) {
+            c = 2 * a + b;
+        }
+        benchmark::DoNotOptimize(z.data());
+    }
+}
+BENCHMARK_REGISTER_F(Misaligned_Int32_3D, AxpyZip)->Range(1 << 10, 1 << 16);
+
+BENCHMARK_DEFINE_F(Misaligned_Int32_3D, AxpyForEach)(benchmark::State& state) {
+    for (auto _ : state) {
+        zip::for_each(zip::zip(std::as_const(x), std::as_const(y), z), [](auto&& row) {
+            auto&& [a, b, c] = row;
+            c = 2 * a + b;
+        });
+        benchmark::DoNotOptimize(z.data());
+    }
+}
+BENCHMARK_REGISTER_F(Misaligned_Int32_3D, AxpyForEach)->Range(1 << 10, 1 << 16);
+
+////////////////////////////////////////////////////////////////////
+
+// The algorithms dispatched at runtime, run by each of their clones in
+// turn: the second argument is the zip::isa forced for the benchmark,
+// which is skipped when the CPU does not support it.
+class Dispatch_Float_2D : public ::benchmark::Fixture {
+   public:
+    void SetUp(::benchmark::State& state) {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        const auto target = static_cast<zip::isa>(state.range(1));
+        previous = zip::set_active_isa(target);
+        if (zip::active_isa() != target) {
+            state.SkipWithError("instruction set not supported");
+        }
+        state.SetLabel(zip::isa_name(target));
+        std::mt19937 rng{42};
+        std::uniform_real_distribution<float> real{-1.f, 1.f};
+        x.resize(size);
+        y.resize(size);
+        out.resize(size);
+        selected.resize(size);
+        order.resize(size);
+        std::generate(x.begin(), x.end(), [&] { return real(rng); });
+        std::generate(y.begin(), y.end(), [&] { return real(rng); });
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), rng);
+    }
+
+    void TearDown(::benchmark::State& state) {
+        zip::set_active_isa(previous);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    static void Arguments(benchmark::internal::Benchmark* b) {
+        for (auto size : {1 << 12, 1 << 16, 1 << 20}) {
+            for (auto target : {zip::isa::generic, zip::isa::sse4_2, zip::isa::avx2,
+                                zip::isa::avx512}) {
+                b->Args({size, static_cast<std::int64_t>(target)});
+            }
+        }
+    }
+
+    zip::isa previous = zip::isa::generic;
+    std::vector<float> x, y, out, selected;
+    std::vector<std::int32_t> order;
+};
+
+BENCHMARK_DEFINE_F(Dispatch_Float_2D, Reduce)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(zip::reduce(x, 0.f));
+    }
+}
+BENCHMARK_REGISTER_F(Dispatch_Float_2D, Reduce)->Apply(Dispatch_Float_2D::Arguments);
+
+BENCHMARK_DEFINE_F(Dispatch_Float_2D, Assign)(benchmark::State& state) {
+    for (auto _ : state) {
+        zip::assign(out, zip::expr(x, y)([](float a, float b) {
+                        return a * b + (a < b ? a : b);
+                    }));
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(Dispatch_Float_2D, Assign)->Apply(Dispatch_Float_2D::Arguments);
+
+BENCHMARK_DEFINE_F(Dispatch_Float_2D, FilterCopy)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(zip::filter_copy(
+            zip::zip(x), [](auto&& row) { return std::get<0>(row) > 0.f; },
+            zip::zip(selected)));
+    }
+}
+BENCHMARK_REGISTER_F(Dispatch_Float_2D, FilterCopy)->Apply(Dispatch_Float_2D::Arguments);
+
+BENCHMARK_DEFINE_F(Dispatch_Float_2D, Gather)(benchmark::State& state) {
+    for (auto _ : state) {
+        zip::gather(zip::zip(x), order, zip::zip(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(Dispatch_Float_2D, Gather)
+    ->Apply(Dispatch_Float_2D::Arguments)
+    ->UseRealTime();
@@ -2,13 +2,22 @@
 #define ZIP_H_INCLUDED_20191008
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
+
 namespace zip {
 
 namespace ttl {
@@ -124,6 +133,341 @@ constexpr auto inner_product(TupleLHS&& lhs, TupleRHS&& rhs, SumNaryOp&& sum, Pr
 // clang-format on
 }  // namespace ttl
 
+//
+// Proxies
+//
+
+template <typename... Refs>
+class reference_tuple;
+
+/// value_tuple is the value type of zipped iterators: a tuple holding
+/// a copy of each element, e.g. the temporary an algorithm stashes
+/// while shuffling elements around. It can be moved out of a
+/// reference_tuple, in which case each element is moved in turn.
+template <typename... Ts>
+class value_tuple : public std::tuple<Ts...> {
+   public:
+    using std::tuple<Ts...>::tuple;
+
+    template <typename... Refs>
+    constexpr value_tuple(const reference_tuple<Refs...>& refs)
+        : value_tuple{refs, std::index_sequence_for<Refs...>{}} {}
+
+    template <typename... Refs>
+    constexpr value_tuple(reference_tuple<Refs...>&& refs)
+        : value_tuple{std::move(refs), std::index_sequence_for<Refs...>{}} {}
+
+   private:
+    template <typename... Refs, std::size_t... Indexes>
+    constexpr value_tuple(const reference_tuple<Refs...>& refs,
+                          std::index_sequence<Indexes...>)
+        : std::tuple<Ts...>{std::get<Indexes>(refs)...} {}
+
+    template <typename... Refs, std::size_t... Indexes>
+    constexpr value_tuple(reference_tuple<Refs...>&& refs, std::index_sequence<Indexes...>)
+        : std::tuple<Ts...>{std::get<Indexes>(std::move(refs))...} {}
+};
+
+/// reference_tuple is the reference type of zipped iterators, i.e.
+/// what they yield when dereferenced: a tuple of references to the
+/// elements of the zipped sequences, or of const values for sequences
+/// computing their elements on the fly (see counting_sequence). It
+/// behaves as a proxy:
+/// - copies refer to the very same elements;
+/// - assignments write through, copying the referred elements just
+///   like std::tuple<T&...> does, even from an rvalue reference_tuple
+///   such as `*in`. Elements are only moved from rvalue references,
+///   i.e. from an rvalue value_tuple or what iter_move() yields;
+/// - swap exchanges the referred elements, and can be called on
+///   temporaries.
+/// This is what lets std::sort and friends permute zipped sequences
+/// in place. Just like the references it holds, a const
+/// reference_tuple still writes through, and one can refer to the
+/// elements of a value_tuple. C++20 ranges algorithms are meant to move
+/// elements through iter_move(), which yields a reference_tuple of rvalue
+/// references, the only way to move the rows of move-only columns.
+template <typename... Refs>
+class reference_tuple : public std::tuple<Refs...> {
+    static_assert(((std::is_reference_v<Refs> || std::is_const_v<Refs>) && ...),
+                  "reference_tuple only holds references or const values");
+
+   public:
+    using std::tuple<Refs...>::tuple;
+
+    constexpr reference_tuple(const reference_tuple&) = default;
+    constexpr reference_tuple(reference_tuple&&) = default;
+
+    template <typename... Us,
+              typename = std::enable_if_t<sizeof...(Us) == sizeof...(Refs)>>
+    constexpr reference_tuple(std::tuple<Us...>& values)
+        : reference_tuple{values, indexes{}} {}
+
+    constexpr reference_tuple& operator=(const reference_tuple& rhs) {
+        assign(rhs, indexes{});
+        return *this;
+    }
+
+    constexpr reference_tuple& operator=(reference_tuple&& rhs) {
+        assign_forward(std::move(rhs), indexes{});
+        return *this;
+    }
+
+    template <typename... Us>
+    constexpr reference_tuple& operator=(const std::tuple<Us...>& rhs) {
+        assign(rhs, indexes{});
+        return *this;
+    }
+
+    template <typename... Us>
+    constexpr reference_tuple& operator=(std::tuple<Us...>&& rhs) {
+        assign_forward(std::move(rhs), indexes{});
+        return *this;
+    }
+
+    constexpr const reference_tuple& operator=(const reference_tuple& rhs) const {
+        assign(rhs, indexes{});
+        return *this;
+    }
+
+    constexpr const reference_tuple& operator=(reference_tuple&& rhs) const {
+        assign_forward(std::move(rhs), indexes{});
+        return *this;
+    }
+
+    template <typename... Us>
+    constexpr const reference_tuple& operator=(const std::tuple<Us...>& rhs) const {
+        assign(rhs, indexes{});
+        return *this;
+    }
+
+    template <typename... Us>
+    constexpr const reference_tuple& operator=(std::tuple<Us...>&& rhs) const {
+        assign_forward(std::move(rhs), indexes{});
+        return *this;
+    }
+
+    friend constexpr void swap(reference_tuple lhs, reference_tuple rhs) {
+        swap_elements(lhs, rhs, indexes{});
+    }
+
+   private:
+    using indexes = std::index_sequence_for<Refs...>;
+
+    template <typename... Us, std::size_t... Indexes>
+    constexpr reference_tuple(std::tuple<Us...>& values, std::index_sequence<Indexes...>)
+        : std::tuple<Refs...>{std::get<Indexes>(values)...} {}
+
+    template <typename Tuple, std::size_t... Indexes>
+    constexpr void assign(const Tuple& rhs, std::index_sequence<Indexes...>) const {
+        ((std::get<Indexes>(*this) = std::get<Indexes>(rhs)), ...);
+    }
+
+    template <typename Tuple, std::size_t... Indexes>
+    constexpr void assign_forward(Tuple&& rhs, std::index_sequence<Indexes...>) const {
+        ((std::get<Indexes>(*this) = std::get<Indexes>(std::forward<Tuple>(rhs))), ...);
+    }
+
+    template <std::size_t... Indexes>
+    static constexpr void swap_elements(reference_tuple& lhs, reference_tuple& rhs,
+                                        std::index_sequence<Indexes...>) {
+        using std::swap;
+        (swap(std::get<Indexes>(lhs), std::get<Indexes>(rhs)), ...);
+    }
+};
+
+namespace impl {
+
+// rvalue_element_t is what the rvalue counterpart of a reference_tuple
+// holds for an element: an rvalue reference, or the same const copy.
+template <typename Ref>
+using rvalue_element_t = std::conditional_t<std::is_reference_v<Ref>,
+                                            std::remove_reference_t<Ref>&&, Ref>;
+
+// move_elements turns the reference of a zipped iterator into its
+// rvalue counterpart, for iter_move(). Other references (e.g. the
+// batches of batch_iterator, which are values) are left as they are.
+template <typename... Refs>
+constexpr reference_tuple<rvalue_element_t<Refs>...> move_elements(
+    const reference_tuple<Refs...>& refs) noexcept {
+    return ttl::transform<reference_tuple<rvalue_element_t<Refs>...>>(
+        refs, [](auto& element) -> decltype(auto) { return std::move(element); });
+}
+
+template <typename T>
+constexpr T move_elements(T value) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    return value;
+}
+
+#if defined(__cpp_lib_ranges)
+// common_element_t is what the common reference of two proxies holds
+// for a pair of elements: their common reference, or a const value
+// when that is not a reference (e.g. along a counting column).
+template <typename T, typename U>
+using common_element_t =
+    std::conditional_t<std::is_reference_v<std::common_reference_t<T, U>>,
+                       std::common_reference_t<T, U>,
+                       std::add_const_t<std::common_reference_t<T, U>>>;
+#endif
+
+}  // namespace impl
+
+//
+// Counting sequences
+//
+
+/// counting_iterator is a random access iterator over consecutive
+/// values of T, computed from its position instead of being loaded
+/// from memory.
+template <typename T>
+class counting_iterator {
+    static_assert(std::is_integral_v<T>, "counting_iterator needs an integral type");
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = T;
+    using pointer = void;
+
+    constexpr counting_iterator() noexcept = default;
+
+    constexpr explicit counting_iterator(T value) noexcept : m_value{value} {}
+
+    constexpr reference operator*() const noexcept { return m_value; }
+
+    constexpr reference operator[](difference_type n) const noexcept {
+        return static_cast<T>(m_value + static_cast<T>(n));
+    }
+
+    constexpr counting_iterator& operator++() noexcept { return *this += 1; }
+
+    constexpr counting_iterator operator++(int) noexcept {
+        auto ret = *this;
+        ++*this;
+        return ret;
+    }
+
+    constexpr counting_iterator& operator--() noexcept { return *this -= 1; }
+
+    constexpr counting_iterator operator--(int) noexcept {
+        auto ret = *this;
+        --*this;
+        return ret;
+    }
+
+    constexpr counting_iterator& operator+=(difference_type n) noexcept {
+        m_value = (*this)[n];
+        return *this;
+    }
+
+    constexpr counting_iterator& operator-=(difference_type n) noexcept {
+        return *this += -n;
+    }
+
+    friend constexpr counting_iterator operator+(counting_iterator it,
+                                                 difference_type n) noexcept {
+        return it += n;
+    }
+
+    friend constexpr counting_iterator operator+(difference_type n,
+                                                 counting_iterator it) noexcept {
+        return it += n;
+    }
+
+    friend constexpr counting_iterator operator-(counting_iterator it,
+                                                 difference_type n) noexcept {
+        return it -= n;
+    }
+
+    friend constexpr difference_type operator-(const counting_iterator& lhs,
+                                               const counting_iterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.m_value) -
+               static_cast<difference_type>(rhs.m_value);
+    }
+
+    friend constexpr bool operator==(const counting_iterator& lhs,
+                                     const counting_iterator& rhs) noexcept {
+        return lhs.m_value == rhs.m_value;
+    }
+
+    friend constexpr bool operator!=(const counting_iterator& lhs,
+                                     const counting_iterator& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const counting_iterator& lhs,
+                                    const counting_iterator& rhs) noexcept {
+        return lhs.m_value < rhs.m_value;
+    }
+
+    friend constexpr bool operator>(const counting_iterator& lhs,
+                                    const counting_iterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const counting_iterator& lhs,
+                                     const counting_iterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const counting_iterator& lhs,
+                                     const counting_iterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+   private:
+    T m_value{};
+};
+
+/// counting_sequence is a sequence of consecutive values of T with no
+/// backing storage: zipping it along other sequences adds a column
+/// holding the row index, which zipped iterators compute from their
+/// position. Such a column is read-only, and a default constructed
+/// sequence counts from zero with no practical upper bound, so that
+/// it never shortens a zip. See also index and enumerate().
+template <typename T>
+class counting_sequence {
+   public:
+    using iterator = counting_iterator<T>;
+    using const_iterator = iterator;
+    using size_type = std::make_unsigned_t<typename iterator::difference_type>;
+
+    constexpr counting_sequence() noexcept : counting_sequence{T{}, unbounded()} {}
+
+    constexpr counting_sequence(T first, T last) noexcept
+        : m_first{first}, m_last{last} {}
+
+    constexpr iterator begin() const noexcept { return iterator{m_first}; }
+
+    constexpr iterator end() const noexcept { return iterator{m_last}; }
+
+    constexpr size_type size() const noexcept {
+        return static_cast<size_type>(end() - begin());
+    }
+
+   private:
+    // The largest value whose distance from zero still fits in a
+    // difference_type.
+    static constexpr T unbounded() noexcept {
+        using limits = std::numeric_limits<typename iterator::difference_type>;
+        if constexpr (std::numeric_limits<T>::digits < limits::digits) {
+            return std::numeric_limits<T>::max();
+        } else {
+            return static_cast<T>(limits::max());
+        }
+    }
+
+    T m_first;
+    T m_last;
+};
+
+template <std::size_t Width, typename... Ts>
+class batch;
+
+/// prefetch_hint tells a prefetch_iterator whether the rows it fetches
+/// ahead are about to be read, or written.
+enum class prefetch_hint { read, write };
+
 namespace policy {
 
 // self(): this CRTP helper casts 'this' to a perfectly
@@ -144,19 +488,30 @@ namespace policy {
         return static_cast<SELF_TYPE const&&>(*this); }
 // clang-format on
 
+// element_reference_t is what a zipped reference holds for the
+// elements of an iterator: an lvalue reference, or a const copy when
+// dereferencing the iterator yields a prvalue.
+template <typename Iterator>
+using element_reference_t =
+    std::conditional_t<std::is_reference_v<decltype(*std::declval<Iterator>())>,
+                       std::remove_reference_t<decltype(*std::declval<Iterator>())>&,
+                       std::add_const_t<decltype(*std::declval<Iterator>())>>;
+
 template <typename... Iterators>
 class pack {
    public:
-    using value_type =
-        std::tuple<std::remove_reference_t<decltype(*std::declval<Iterators>())>&...>;
-    using pointer = value_type;
-    using reference = value_type;
+    using value_type = value_tuple<
+        std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<Iterators>())>>...>;
+    using reference = reference_tuple<element_reference_t<Iterators>...>;
+    using pointer = reference;
     using pack_type = std::tuple<std::remove_reference_t<Iterators>...>;
     using iterator_category = std::common_type_t<
         typename std::iterator_traits<Iterators>::iterator_category...>;
     using difference_type =
         std::common_type_t<typename std::iterator_traits<Iterators>::difference_type...>;
 
+    constexpr pack() = default;
+
     constexpr pack(Iterators... iterators) noexcept
         : m_iterators{std::move(iterators)...} {}
 
@@ -178,8 +533,8 @@ class dereference {
     ZIP_ADD_CRTP_SELF_ACCESSOR(self_type)
 
    public:
-    constexpr typename IteratorPack::value_type operator*() const {
-        return ttl::transform<typename IteratorPack::value_type>(
+    constexpr typename IteratorPack::reference operator*() const {
+        return ttl::transform<typename IteratorPack::reference>(
             self().iterators(), [](auto&& it) -> decltype(auto) { return *it; });
     }
 };
@@ -274,6 +629,11 @@ class random_access {
                 self().iterators(), [rhs](auto&& it) { return it + rhs; }));
     }
 
+    friend constexpr self_type operator+(typename IteratorPack::difference_type lhs,
+                                         const self_type& rhs) {
+        return rhs + lhs;
+    }
+
     constexpr self_type& operator+=(typename IteratorPack::difference_type rhs) {
         ttl::for_each(self().iterators(), [rhs](auto&& it) { it += rhs; });
         return self();
@@ -297,13 +657,61 @@ class random_access {
         return self();
     }
 
-    constexpr typename IteratorPack::value_type operator[](
+    constexpr typename IteratorPack::reference operator[](
         typename IteratorPack::difference_type rhs) const {
-        return ttl::transform<typename IteratorPack::value_type>(
+        return ttl::transform<typename IteratorPack::reference>(
             self().iterators(), [rhs](auto&& it) -> decltype(auto) { return it[rhs]; });
     }
 };
 
+// lockstep policy class is a random access policy for iterator packs
+// whose iterators are known to move together, as it happens when
+// they are all created by the same zip_view: comparisons and
+// differences then only need to look at the first iterator, so that
+// the loop termination test is a single compare no matter how many
+// sequences are zipped.
+template <typename IteratorBase, typename IteratorPack>
+class lockstep : public random_access<IteratorBase, IteratorPack> {
+    using self_type = IteratorBase;
+    ZIP_ADD_CRTP_SELF_ACCESSOR(self_type)
+
+   public:
+    using random_access<IteratorBase, IteratorPack>::operator-;
+
+    constexpr bool operator==(const self_type& rhs) const {
+        using std::get;
+        return get<0>(self().iterators()) == get<0>(rhs.iterators());
+    }
+
+    constexpr bool operator!=(const self_type& rhs) const { return !(self() == rhs); }
+
+    constexpr bool operator<(const self_type& rhs) const {
+        using std::get;
+        return get<0>(self().iterators()) < get<0>(rhs.iterators());
+    }
+
+    constexpr bool operator<=(const self_type& rhs) const {
+        using std::get;
+        return get<0>(self().iterators()) <= get<0>(rhs.iterators());
+    }
+
+    constexpr bool operator>(const self_type& rhs) const {
+        using std::get;
+        return get<0>(self().iterators()) > get<0>(rhs.iterators());
+    }
+
+    constexpr bool operator>=(const self_type& rhs) const {
+        using std::get;
+        return get<0>(self().iterators()) >= get<0>(rhs.iterators());
+    }
+
+    constexpr typename IteratorPack::difference_type operator-(
+        const self_type& rhs) const {
+        using std::get;
+        return get<0>(self().iterators()) - get<0>(rhs.iterators());
+    }
+};
+
 // offset policy class provides all the functionalities of a
 // regular random access iterator on an iterator pack in the
 // fastest way. It prioritizes performances over correctness:
@@ -361,6 +769,12 @@ struct offset {
         return ret;
     }
 
+    friend constexpr self_type operator+(
+        typename IteratorPack::difference_type lhs,
+        const self_type& rhs) noexcept(std::is_nothrow_copy_constructible_v<self_type>) {
+        return rhs + lhs;
+    }
+
     constexpr self_type& operator++() noexcept {
         ++m_offset;
         return self();
@@ -410,18 +824,220 @@ struct offset {
     }
 
     // Dereference
-    constexpr typename IteratorPack::value_type operator*() const noexcept {
+    constexpr typename IteratorPack::reference operator*() const noexcept {
         return operator[](0);
     }
 
-    constexpr typename IteratorPack::value_type operator[](
+    constexpr typename IteratorPack::reference operator[](
         typename IteratorPack::difference_type rhs) const noexcept {
         rhs += m_offset;
-        return ttl::transform<typename IteratorPack::value_type>(
+        return ttl::transform<typename IteratorPack::reference>(
             self().iterators(), [rhs](auto&& it) -> decltype(auto) { return it[rhs]; });
     }
 };
 
+// batch_pack is an iterator pack whose dereference yields W-wide
+// batches of lanes, one std::array per zipped sequence, instead of
+// a tuple of references to single elements.
+template <std::size_t Width, typename... Iterators>
+class batch_pack : public pack<Iterators...> {
+   public:
+    static constexpr std::size_t width = Width;
+    using value_type = ::zip::batch<
+        Width,
+        std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<Iterators>())>>...>;
+    using pointer = void;
+    using reference = value_type;
+    using iterator_category = std::forward_iterator_tag;
+
+    constexpr batch_pack() = default;
+
+    constexpr batch_pack(Iterators... iterators) noexcept
+        : pack<Iterators...>{std::move(iterators)...} {}
+};
+
+// batched policy class walks an iterator pack W elements at a time,
+// loading each step into fixed-size lane arrays. Just like offset,
+// it advances all the wrapped iterators using a single offset, so
+// it comes with the very same assumptions: random access iterators
+// and sequences at least as long as the iteration space. The last
+// step is masked: when fewer than W elements are left, the tail
+// lanes are value-initialised and reported as inactive.
+template <typename IteratorBase, typename IteratorPack>
+struct batched {
+    using self_type = IteratorBase;
+    ZIP_ADD_CRTP_SELF_ACCESSOR(self_type)
+
+    static constexpr auto width =
+        static_cast<typename IteratorPack::difference_type>(IteratorPack::width);
+
+    typename IteratorPack::difference_type m_offset{};
+    typename IteratorPack::difference_type m_size{};
+
+   public:
+    constexpr bool operator==(const self_type& rhs) const noexcept {
+        return m_offset == rhs.m_offset;
+    }
+
+    constexpr bool operator!=(const self_type& rhs) const noexcept {
+        return !(self() == rhs);
+    }
+
+    constexpr self_type& operator++() noexcept {
+        m_offset += width;
+        return self();
+    }
+
+    constexpr self_type operator++(int) noexcept {
+        self_type prev{self()};
+        m_offset += width;
+        return prev;
+    }
+
+    constexpr typename IteratorPack::value_type operator*() const {
+        using indexes = std::make_index_sequence<
+            std::tuple_size_v<typename IteratorPack::pack_type>>;
+        const auto active = std::min(width, m_size - m_offset);
+        if (active == width) {
+            return load(indexes{});
+        }
+        typename IteratorPack::value_type ret{static_cast<std::size_t>(active)};
+        load_tail(ret, active, indexes{});
+        return ret;
+    }
+
+   private:
+    // Full steps: lanes are initialised straight from the sequences,
+    // the trip count being a compile time constant.
+    template <std::size_t... Indexes>
+    constexpr typename IteratorPack::value_type load(
+        std::index_sequence<Indexes...>) const {
+        using std::get;
+        using lanes = std::make_index_sequence<IteratorPack::width>;
+        return {IteratorPack::width,
+                load_lanes(get<Indexes>(self().iterators()), lanes{})...};
+    }
+
+    template <typename Iterator, std::size_t... Lanes>
+    constexpr auto load_lanes(const Iterator& it, std::index_sequence<Lanes...>) const {
+        using difference_type = typename IteratorPack::difference_type;
+        using value_type = std::remove_cv_t<std::remove_reference_t<decltype(*it)>>;
+        return std::array<value_type, IteratorPack::width>{
+            {it[m_offset + static_cast<difference_type>(Lanes)]...}};
+    }
+
+    // Masked step: only active lanes are loaded.
+    template <std::size_t... Indexes>
+    constexpr void load_tail(typename IteratorPack::value_type& ret,
+                             typename IteratorPack::difference_type count,
+                             std::index_sequence<Indexes...>) const {
+        using std::get;
+        (load_tail_lanes(get<Indexes>(ret), get<Indexes>(self().iterators()), count),
+         ...);
+    }
+
+    template <typename Lanes, typename Iterator>
+    constexpr void load_tail_lanes(Lanes& lanes, const Iterator& it,
+                                   typename IteratorPack::difference_type count) const {
+        for (typename IteratorPack::difference_type i = 0; i < count; ++i) {
+            lanes[static_cast<std::size_t>(i)] = it[m_offset + i];
+        }
+    }
+};
+
+// no_alias_pack is an iterator pack of pointers to sequences that do
+// not overlap, see no_alias_iterator.
+template <typename... Iterators>
+class no_alias_pack : public pack<Iterators...> {
+    static_assert((std::is_pointer_v<Iterators> && ...),
+                  "no_alias needs contiguous sequences");
+
+   public:
+    constexpr no_alias_pack() = default;
+
+    constexpr no_alias_pack(Iterators... iterators) noexcept
+        : pack<Iterators...>{std::move(iterators)...} {}
+};
+
+// prefetch_pack is an iterator pack carrying the prefetch distance
+// and hint of a prefetch_iterator.
+template <std::size_t Distance, prefetch_hint Hint, typename... Iterators>
+class prefetch_pack : public pack<Iterators...> {
+   public:
+    static constexpr std::size_t distance = Distance;
+    static constexpr prefetch_hint hint = Hint;
+
+    constexpr prefetch_pack() = default;
+
+    constexpr prefetch_pack(Iterators... iterators) noexcept
+        : pack<Iterators...>{std::move(iterators)...} {}
+};
+
+// prefetched policy class is an offset policy whose increments and
+// subscripts also hint the caches about the row the given distance
+// ahead, in all the wrapped sequences. Sequences yielding elements
+// computed on the fly have nothing to prefetch and are left alone,
+// the others get the address of that element prefetched: for an
+// index indirection, that is the target of the index, whose load is
+// exactly the one hardware prefetchers cannot see coming. Rows past
+// m_size are never touched.
+template <typename IteratorBase, typename IteratorPack>
+struct prefetched : offset<IteratorBase, IteratorPack> {
+    using self_type = IteratorBase;
+    ZIP_ADD_CRTP_SELF_ACCESSOR(self_type)
+
+    using offset<IteratorBase, IteratorPack>::m_offset;
+
+    static constexpr auto distance =
+        static_cast<typename IteratorPack::difference_type>(IteratorPack::distance);
+
+    typename IteratorPack::difference_type m_size{};
+
+   public:
+    self_type& operator++() noexcept {
+        ++m_offset;
+        prefetch(m_offset);
+        return self();
+    }
+
+    self_type operator++(int) noexcept {
+        self_type prev{self()};
+        ++*this;
+        return prev;
+    }
+
+    typename IteratorPack::reference operator[](
+        typename IteratorPack::difference_type rhs) const noexcept {
+        prefetch(m_offset + rhs);
+        return offset<IteratorBase, IteratorPack>::operator[](rhs);
+    }
+
+   private:
+    void prefetch(
+        [[maybe_unused]] typename IteratorPack::difference_type row) const noexcept {
+        if constexpr (distance > 0) {
+            const auto ahead = row + distance;
+            if (ahead < m_size) {
+                std::apply(
+                    [ahead](auto const&... its) { (prefetch_element(its, ahead), ...); },
+                    self().iterators());
+            }
+        }
+    }
+
+    template <typename Iterator>
+    static void prefetch_element(
+        [[maybe_unused]] const Iterator& it,
+        [[maybe_unused]] typename IteratorPack::difference_type row) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        if constexpr (std::is_lvalue_reference_v<decltype(it[row])>) {
+            constexpr int rw = IteratorPack::hint == prefetch_hint::write ? 1 : 0;
+            __builtin_prefetch(std::addressof(it[row]), rw);
+        }
+#endif
+    }
+};
+
 #ifdef ZIP_ADD_CRTP_SELF_ACCESSOR
 #undef ZIP_ADD_CRTP_SELF_ACCESSOR
 #endif
@@ -434,12 +1050,33 @@ struct offset {
 
 struct offset_iterator_tag : public std::random_access_iterator_tag {};
 
+/// no_alias_iterator_tag is the iterator category of the views over
+/// sequences that do not overlap, see no_alias.
+struct no_alias_iterator_tag : public offset_iterator_tag {};
+
+// iterator puts together an iterator pack and the policies built on
+// top of it. Zipped iterators are default constructible and copyable
+// like any other iterator, so that random access ones also work with
+// the parallel overloads of the standard algorithms (e.g. with
+// std::execution::par_unseq), which split them across threads.
 template <typename IteratorPack,
           template <typename Pack, typename Self> typename... Policies>
 class iterator : public IteratorPack,
                  public Policies<iterator<IteratorPack, Policies...>, IteratorPack>... {
    public:
     using IteratorPack::IteratorPack;
+
+    /// iter_move moves the elements of a row out, e.g. for the C++20
+    /// ranges algorithms: it yields a reference_tuple of rvalue
+    /// references.
+    friend constexpr auto iter_move(const iterator& it) noexcept(noexcept(*it)) {
+        return impl::move_elements(*it);
+    }
+
+    /// iter_swap exchanges the elements of two rows.
+    friend constexpr void iter_swap(const iterator& lhs, const iterator& rhs) {
+        swap(*lhs, *rhs);
+    }
 };
 
 // clang-format off
@@ -471,6 +1108,19 @@ using random_access_iterator =
         policy::totally_ordered,
         policy::random_access>;
 
+// lockstep_iterator is the random access iterator handed out by
+// zip_view: since the view bounds all the zipped sequences to the
+// same length, their iterators always move together and only the
+// first one takes part in comparisons.
+template <typename... Iterators>
+using lockstep_iterator =
+    iterator<
+        policy::pack<Iterators...>,
+        policy::dereference,
+        policy::incrementable,
+        policy::decrementable,
+        policy::lockstep>;
+
 // offset_iterator focuses on performance (e.g.: iteration loops vectorisability)
 // over correctness: it works only on random access iterators and behaves
 // correctly only when all the zipped sequences are of the same length,
@@ -481,6 +1131,31 @@ using offset_iterator =
     iterator<
         policy::pack<Iterators...>,
         policy::offset>;
+
+// batch_iterator walks the zipped sequences W elements at a time,
+// see batches().
+template <std::size_t Width, typename... Iterators>
+using batch_iterator =
+    iterator<
+        policy::batch_pack<Width, Iterators...>,
+        policy::batched>;
+
+// no_alias_iterator is an offset_iterator over contiguous sequences
+// that do not overlap, see no_alias. It walks them just the same, the
+// loop drivers (for_each, assign...) tell compilers about it.
+template <typename... Iterators>
+using no_alias_iterator =
+    iterator<
+        policy::no_alias_pack<Iterators...>,
+        policy::offset>;
+
+// prefetch_iterator is an offset_iterator prefetching rows Distance
+// steps ahead of those it walks, see prefetched().
+template <std::size_t Distance, prefetch_hint Hint, typename... Iterators>
+using prefetch_iterator =
+    iterator<
+        policy::prefetch_pack<Distance, Hint, Iterators...>,
+        policy::prefetched>;
 // clang-format on
 
 //
@@ -503,6 +1178,54 @@ inline constexpr bool is_compatible_iterator_category_v =
     is_iterator_category_v<A> && is_iterator_category_v<B> &&
     std::is_convertible_v<std::add_lvalue_reference_t<A>, std::add_lvalue_reference_t<B>>;
 
+/// is_contiguous_sequence_v tells whether a sequence stores its
+/// elements contiguously, i.e. whether it exposes its size and a
+/// pointer to its storage (e.g.: C arrays, std::array, std::vector,
+/// std::string, std::span).
+template <typename T, typename = void>
+struct is_contiguous_sequence : std::false_type {};
+
+template <typename T>
+struct is_contiguous_sequence<T, std::void_t<decltype(std::data(std::declval<T&>())),
+                                             decltype(std::size(std::declval<T&>()))>>
+    : std::is_pointer<decltype(std::data(std::declval<T&>()))> {};
+
+template <typename T>
+inline constexpr bool is_contiguous_sequence_v = is_contiguous_sequence<T>::value;
+
+/// is_counting_sequence_v tells whether a sequence is a
+/// counting_sequence, whose elements are computed from their index.
+template <typename T>
+struct is_counting_sequence : std::false_type {};
+
+template <typename T>
+struct is_counting_sequence<counting_sequence<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_counting_sequence_v =
+    is_counting_sequence<std::remove_cv_t<T>>::value;
+
+template <typename T>
+struct is_offset_iterator : std::false_type {};
+
+template <typename... Iterators>
+struct is_offset_iterator<offset_iterator<Iterators...>> : std::true_type {};
+
+template <typename... Iterators>
+struct is_offset_iterator<no_alias_iterator<Iterators...>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_offset_iterator_v = is_offset_iterator<T>::value;
+
+template <typename T>
+struct is_no_alias_iterator : std::false_type {};
+
+template <typename... Iterators>
+struct is_no_alias_iterator<no_alias_iterator<Iterators...>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_no_alias_iterator_v = is_no_alias_iterator<T>::value;
+
 /// iterator_type is a metafunction that returns a zipped iterator type
 /// according the specified IteratorCategory and packs in it the list
 /// of specified iterator types.
@@ -529,6 +1252,11 @@ struct iterator_type<offset_iterator_tag, Iterators...> {
     using type = offset_iterator<Iterators...>;
 };
 
+template <typename... Iterators>
+struct iterator_type<no_alias_iterator_tag, Iterators...> {
+    using type = no_alias_iterator<Iterators...>;
+};
+
 /// iterator_type_t is a metafunction that returns a zipped iterator type
 /// according the specified IteratorCategory and packs in it the list
 /// of specified iterator types.
@@ -565,46 +1293,183 @@ constexpr auto make_iterator(Iterators&&... args) {
     return make_iterator(iterator_category{}, std::forward<Iterators>(args)...);
 }
 
+namespace impl {
+
+// sequence_begin returns the iterator used to walk a sequence as part
+// of a zipped iterator of the given category: when driven by a single
+// offset, contiguous sequences are better off with a plain pointer.
+template <typename IteratorCategory, typename Sequence>
+constexpr auto sequence_begin(IteratorCategory, Sequence& seq) {
+    if constexpr (is_compatible_iterator_category_v<IteratorCategory,
+                                                    offset_iterator_tag> &&
+                  is_contiguous_sequence_v<Sequence>) {
+        return std::data(seq);
+    } else {
+        return std::begin(seq);
+    }
+}
+
+template <typename IteratorCategory, typename Sequence>
+using sequence_begin_t = decltype(sequence_begin(std::declval<IteratorCategory>(),
+                                                 std::declval<Sequence&>()));
+
+template <typename T, typename = void>
+struct has_iterator_pack : std::false_type {};
+
+template <typename T>
+struct has_iterator_pack<T, std::void_t<decltype(std::declval<T&>().iterators())>>
+    : std::true_type {};
+
+// as_offset turns any zipped random access iterator into the
+// equivalent offset_iterator, so that loops over a chunk are driven
+// by a single induction variable. Anything else is left alone.
+template <typename Iterator>
+constexpr auto as_offset(Iterator it) {
+    if constexpr (is_offset_iterator_v<Iterator> ||
+                  !has_iterator_pack<Iterator>::value) {
+        return it;
+    } else {
+        return std::apply(
+            [](auto... its) {
+                return make_iterator(offset_iterator_tag{}, std::move(its)...);
+            },
+            it.iterators());
+    }
+}
+
+// Compilers only take the guarantee of __restrict from function
+// parameters, and only for the accesses written in the body of that
+// function: on members of the iterator pack, on local copies of the
+// pointers, or in a function called with them, the qualifier is
+// ignored. So restrict_rows holds the loop itself, calling f(rows, i)
+// for the first size rows of the offset_iterator over its parameters.
+template <typename Function, typename... Ts>
+constexpr void restrict_rows(Function& f, std::ptrdiff_t size,
+                             Ts* __restrict... columns) {
+    const offset_iterator<Ts*...> rows{columns...};
+    for (std::ptrdiff_t i = 0; i < size; ++i) {
+        f(rows, i);
+    }
+}
+
+// no_alias_rows calls f(rows, i) for the first size rows from the
+// no_alias_iterator it, rows walking the same rows as it through
+// __restrict parameters, so that the loop needs no runtime overlap
+// check.
+template <typename Iterator, typename Function>
+constexpr void no_alias_rows(const Iterator& it, std::ptrdiff_t size, Function&& f) {
+    static_assert(is_no_alias_iterator_v<Iterator>,
+                  "no_alias_rows needs no_alias columns");
+    std::apply(
+        [&](auto... columns) { restrict_rows(f, size, (columns + it.m_offset)...); },
+        it.iterators());
+}
+
+// disjoint_columns tells whether the first rows of the given columns
+// do not overlap, except for columns that are only read.
+template <typename... Ts>
+bool disjoint_columns(std::ptrdiff_t rows, Ts*... columns) {
+    struct extent {
+        std::uintptr_t first;
+        std::uintptr_t last;
+        bool written;
+    };
+    const extent extents[] = {{reinterpret_cast<std::uintptr_t>(columns),
+                               reinterpret_cast<std::uintptr_t>(columns + rows),
+                               !std::is_const_v<Ts>}...};
+    for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+        for (std::size_t j = i + 1; j < sizeof...(Ts); ++j) {
+            const auto& a = extents[i];
+            const auto& b = extents[j];
+            if ((a.written || b.written) && a.first < b.last && b.first < a.last) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// view_iterator maps the iterator category of a zip_view to the
+// iterator type it hands out: random access views know the common
+// length of their sequences, so their iterators can move in lockstep.
+template <typename IteratorCategory, typename... Iterators>
+struct view_iterator : iterator_type<IteratorCategory, Iterators...> {};
+
+template <typename... Iterators>
+struct view_iterator<std::random_access_iterator_tag, Iterators...> {
+    using type = lockstep_iterator<Iterators...>;
+};
+
+template <typename IteratorCategory, typename... Iterators>
+using view_iterator_t = typename view_iterator<IteratorCategory, Iterators...>::type;
+
+}  // namespace impl
+
+/// zip_view is the iterable returned by zip(). Random access views
+/// compute the common length of their sequences once, at
+/// construction: end() is then begin() plus that length, and the
+/// loop termination test boils down to a single compare. As a
+/// consequence, the sequences must not be resized while the view
+/// is in use. Views refer to the sequences they zip, like
+/// std::ranges::ref_view: they are cheap to copy, and copies iterate
+/// the same sequences, with the same (non const) iterators when const.
 template <typename IteratorCategory, typename... Sequences>
 struct zip_view {
     using iterator_category = IteratorCategory;
     // Why the & is needed while declval-ing Sequences:
     // https://stackoverflow.com/questions/42580761/why-does-stdbegin-always-return-const-iterator-in-such-a-case
     // clang-format off
-    using iterator = 
-        decltype(make_iterator(std::declval<iterator_category>(), std::begin(std::declval<Sequences&>())...));
+    using iterator =
+        impl::view_iterator_t<iterator_category,
+                              impl::sequence_begin_t<iterator_category, Sequences>...>;
     using const_iterator =
-        decltype(make_iterator(std::declval<iterator_category>(), std::cbegin(std::declval<Sequences&>())...));
-
-    using sequences = std::tuple<Sequences&...>;
+        impl::view_iterator_t<iterator_category,
+                              impl::sequence_begin_t<iterator_category, const std::remove_reference_t<Sequences>>...>;
+    using size_type = std::make_unsigned_t<typename iterator::difference_type>;
 
-    constexpr zip_view(Sequences&... sqs) noexcept : m_sequences{sqs...} {}
+    constexpr zip_view(Sequences&... sqs) : m_sequences{&sqs...}, m_size{common_size()} {}
 
-    constexpr iterator begin()
-        noexcept((noexcept(std::begin(std::declval<Sequences&>())) && ...)) {
-        return ttl::transform<iterator>(
-            m_sequences, [](auto&& seq) { return std::begin(seq); });
+    constexpr iterator begin() const {
+        return ttl::transform<iterator>(m_sequences, [](auto* seq) {
+            return impl::sequence_begin(iterator_category{}, *seq);
+        });
     }
 
-    constexpr iterator end() 
-        noexcept((noexcept(std::end(std::declval<Sequences&>())) && ...)) {
-        return ttl::transform<iterator>(
-            m_sequences, [](auto&& seq) { return std::end(seq); });
+    constexpr iterator end() const {
+        if constexpr (is_random_access_category) {
+            return begin() + m_size;
+        } else {
+            return ttl::transform<iterator>(
+                m_sequences, [](auto* seq) { return std::end(*seq); });
+        }
     }
 
-    constexpr const_iterator cbegin() const
-        noexcept((noexcept(std::cbegin(std::declval<Sequences&>())) && ...)) {
-        return ttl::transform<const_iterator>(
-            m_sequences, [](auto&& seq) { return std::cbegin(seq); });
+    constexpr const_iterator cbegin() const {
+        return ttl::transform<const_iterator>(m_sequences, [](auto* seq) {
+            return impl::sequence_begin(iterator_category{}, std::as_const(*seq));
+        });
     }
 
-    constexpr const_iterator cend() const
-        noexcept((noexcept(std::cend(std::declval<Sequences&>())) && ...)) {
-        return ttl::transform<const_iterator>(
-            m_sequences, [](auto&& seq) { return std::cend(seq); });
+    constexpr const_iterator cend() const {
+        if constexpr (is_random_access_category) {
+            return cbegin() + m_size;
+        } else {
+            return ttl::transform<const_iterator>(
+                m_sequences, [](auto* seq) { return std::cend(*seq); });
+        }
     }
     // clang-format on
 
+    /// Length of the shortest sequence, only available on random
+    /// access views.
+    template <typename T = size_type,
+              typename = std::enable_if_t<
+                  sizeof(T) && is_compatible_iterator_category_v<
+                                   iterator_category, std::random_access_iterator_tag>>>
+    constexpr size_type size() const noexcept {
+        return static_cast<size_type>(m_size);
+    }
+
     // TODO how to reasonably SFINAE on this?
     // Cannot enable_if on:
     // * return type: without auto, it must be calculated anyway
@@ -617,18 +1482,45 @@ struct zip_view {
                   sizeof(T) &&
                   is_compatible_iterator_category_v<typename iterator::iterator_category,
                                                     std::random_access_iterator_tag>>>
-    constexpr auto operator[](T idx) {
+    constexpr auto operator[](T idx) const {
         return begin()[idx];
     }
 
    private:
-    sequences m_sequences;
+    static constexpr bool is_random_access_category =
+        is_compatible_iterator_category_v<iterator_category,
+                                          std::random_access_iterator_tag>;
+
+    // Both offset and lockstep iterators compare just the first
+    // sequence: the end of the iteration space is the end of the
+    // shortest sequence, so that zipping sequences of different
+    // lengths stays safe. Other views stop as soon as any of the
+    // sequences hits its own end, they need no length.
+    constexpr typename iterator::difference_type common_size() const {
+        if constexpr (is_random_access_category) {
+            return std::apply(
+                [](auto*... seq) {
+                    return std::min({static_cast<typename iterator::difference_type>(
+                        std::distance(std::begin(*seq), std::end(*seq)))...});
+                },
+                m_sequences);
+        } else {
+            return 0;
+        }
+    }
+
+    std::tuple<std::remove_reference_t<Sequences>*...> m_sequences;
+    typename iterator::difference_type m_size;
 };
 
 /// zip wraps a sequence of iterators into one single type
 /// that is iterable in a python-like zip fashion.
-/// The iterator category is deduced as the least-upper-bound
-/// of all the arguments' iterator categories.
+/// When all the sequences are contiguous (or counting sequences),
+/// the iterator category is deduced as offset: sequences are
+/// walked through plain pointers driven by a single shared offset,
+/// up to the end of the shortest one. Otherwise, the iterator category is deduced
+/// as the least-upper-bound of all the arguments' iterator
+/// categories.
 /// It's possible to ask for a specific iterator category by
 /// passing it as the first argument; if it turns out to be
 /// not convertible to the actual least-upper-bound of the
@@ -644,18 +1536,653 @@ constexpr auto zip(IteratorCategory, Sequences&&... args) {
         "deduced common iterator category is not compatible with requested iterator "
         "category");
     using return_type = zip_view<IteratorCategory, Sequences...>;
-    return return_type{std::forward<Sequences>(args)...};
+    return_type view{std::forward<Sequences>(args)...};
+    if constexpr (std::is_same_v<IteratorCategory, no_alias_iterator_tag>) {
+        assert(std::apply(
+            [&view](auto... columns) {
+                return impl::disjoint_columns(
+                    static_cast<std::ptrdiff_t>(view.size()), columns...);
+            },
+            view.begin().iterators()));
+    }
+    return view;
 }
 
+/// no_alias, passed as first argument to zip(), declares that the
+/// sequences to zip do not overlap in memory, save for sequences that
+/// are only read:
+///
+///     zip::for_each(zip::zip(zip::no_alias, out, a, b), [](auto&& row) {
+///         auto&& [o, x, y] = row;
+///         o = x * y;
+///     });
+///
+/// The sequences must be contiguous, their view is an offset view.
+/// Loops run by for_each and assign (when writing to such a view)
+/// then vectorise without the runtime overlap checks, and scalar
+/// fallback loops, compilers otherwise add. Plain loops over the view
+/// do not benefit. Overlaps are undefined behaviour, caught by an
+/// assertion in debug builds.
+inline constexpr no_alias_iterator_tag no_alias{};
+
 template <
     typename... Sequences,
     typename = std::enable_if_t<!is_iterator_category_v<nth_type_t<0, Sequences...>>>>
 constexpr auto zip(Sequences&&... args) {
-    using iterator_category =
-        common_iterator_category_t<sequence_iterator_t<Sequences>...>;
+    using iterator_category = std::conditional_t<
+        ((is_contiguous_sequence_v<std::remove_reference_t<Sequences>> ||
+          is_counting_sequence_v<std::remove_reference_t<Sequences>>) &&
+         ...),
+        offset_iterator_tag, common_iterator_category_t<sequence_iterator_t<Sequences>...>>;
     return zip(iterator_category{}, std::forward<Sequences>(args)...);
 }
 
+/// index is the counting sequence of all the row indexes, to be
+/// zipped along other sequences (zip_view refers to the sequences it
+/// zips, so this one has to outlive any view).
+inline constexpr counting_sequence<std::size_t> index{};
+
+/// enumerate zips the row index along with the given sequences, as
+/// the first column:
+///
+///     for (auto&& [i, x, y] : zip::enumerate(xs, ys)) { ... }
+///
+/// Indexes are computed from the shared offset of the iterators, no
+/// memory is allocated nor loaded for them.
+template <typename... Sequences>
+constexpr auto enumerate(Sequences&&... args) {
+    return zip(index, std::forward<Sequences>(args)...);
+}
+
+//
+// Batches
+//
+
+/// batch is the value produced at each step of a batched traversal:
+/// a tuple holding one W-wide lane array for each zipped sequence.
+/// Only the first size() lanes are active, the others (on the last,
+/// masked step) are value-initialised.
+template <std::size_t Width, typename... Ts>
+class batch : public std::tuple<std::array<Ts, Width>...> {
+   public:
+    static constexpr std::size_t width = Width;
+
+    constexpr explicit batch(std::size_t size) noexcept : m_size{size} {}
+
+    constexpr batch(std::size_t size, std::array<Ts, Width>... lanes) noexcept
+        : std::tuple<std::array<Ts, Width>...>{std::move(lanes)...}, m_size{size} {}
+
+    constexpr std::size_t size() const noexcept { return m_size; }
+
+    constexpr bool active(std::size_t lane) const noexcept { return lane < m_size; }
+
+    constexpr std::array<bool, Width> mask() const noexcept {
+        std::array<bool, Width> ret{};
+        for (std::size_t i = 0; i < Width; ++i) {
+            ret[i] = active(i);
+        }
+        return ret;
+    }
+
+   private:
+    std::size_t m_size;
+};
+
+/// batch_view is the range returned by batches().
+template <typename Iterator>
+class batch_view {
+   public:
+    using iterator = Iterator;
+
+    constexpr batch_view(iterator first, iterator last) noexcept
+        : m_begin{std::move(first)}, m_end{std::move(last)} {}
+
+    constexpr iterator begin() const noexcept { return m_begin; }
+
+    constexpr iterator end() const noexcept { return m_end; }
+
+   private:
+    iterator m_begin{};
+    iterator m_end{};
+};
+
+/// batches turns a random access sequence of zipped elements (usually
+/// a zip_view) into a sequence of batches, each one made of Width
+/// consecutive elements loaded in fixed-size lane arrays. Kernels
+/// written against the lanes get a constant trip count, which makes
+/// vectorisation a given instead of a matter of compiler heuristics:
+///
+///     for (auto&& [x, y] : zip::batches<8>(zip::zip(a, b))) {
+///         for (std::size_t i = 0; i < 8; ++i) { sum[i] += x[i] * y[i]; }
+///     }
+///
+/// Batches are loaded by value: writes have to go through the regular
+/// zipped iterators.
+template <std::size_t Width, typename Sequence>
+constexpr auto batches(Sequence&& seq) {
+    static_assert(Width > 0, "batch width must be positive");
+    using std::begin;
+    using std::end;
+    auto first = begin(seq);
+    using zipped_iterator = decltype(first);
+    static_assert(is_compatible_iterator_category_v<
+                      typename zipped_iterator::iterator_category,
+                      std::random_access_iterator_tag>,
+                  "batches needs a random access sequence");
+    const auto size = end(seq) - first;
+    auto base = typename zipped_iterator::difference_type{};
+    if constexpr (is_offset_iterator_v<zipped_iterator>) {
+        base = first.m_offset;
+    }
+    auto make = [](auto&&... its) {
+        return batch_iterator<Width, std::decay_t<decltype(its)>...>{its...};
+    };
+    auto it_begin = std::apply(make, first.iterators());
+    it_begin.m_offset = base;
+    it_begin.m_size = base + size;
+    auto it_end = it_begin;
+    const auto width = static_cast<typename zipped_iterator::difference_type>(Width);
+    it_end.m_offset = base + (size + width - 1) / width * width;
+    return batch_view<decltype(it_begin)>{it_begin, it_end};
+}
+
+//
+// Chunks
+//
+
+/// slice is a pair of random access iterators seen as a range: it is
+/// what chunks() returns, and each of the chunks it yields.
+template <typename Iterator>
+class slice {
+   public:
+    using iterator = Iterator;
+    using value_type = typename std::iterator_traits<iterator>::value_type;
+    using difference_type = typename std::iterator_traits<iterator>::difference_type;
+    using size_type = std::make_unsigned_t<difference_type>;
+
+    constexpr slice() = default;
+
+    constexpr slice(iterator first, iterator last) noexcept
+        : m_begin{std::move(first)}, m_end{std::move(last)} {}
+
+    constexpr iterator begin() const noexcept { return m_begin; }
+
+    constexpr iterator end() const noexcept { return m_end; }
+
+    constexpr size_type size() const noexcept {
+        return static_cast<size_type>(m_end - m_begin);
+    }
+
+    constexpr bool empty() const noexcept { return m_begin == m_end; }
+
+    /// Slices over pointers are contiguous sequences.
+    template <typename T = iterator, typename = std::enable_if_t<std::is_pointer_v<T>>>
+    constexpr T data() const noexcept {
+        return m_begin;
+    }
+
+    constexpr decltype(auto) operator[](difference_type idx) const {
+        return m_begin[idx];
+    }
+
+   private:
+    iterator m_begin;
+    iterator m_end;
+};
+
+/// chunk_iterator walks a random access sequence n rows at a time,
+/// each step yielding the slice of the next (at most) n rows. It only
+/// stores the position of the current chunk: moving around and
+/// dereferencing never allocate.
+template <typename Iterator>
+class chunk_iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = slice<Iterator>;
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    using reference = value_type;
+    using pointer = void;
+
+    chunk_iterator() = default;
+
+    constexpr chunk_iterator(Iterator first, difference_type offset, difference_type rows,
+                             difference_type size) noexcept
+        : m_first{std::move(first)}, m_offset{offset}, m_rows{rows}, m_size{size} {}
+
+    constexpr reference operator*() const {
+        return {m_first + m_offset, m_first + std::min(m_offset + m_rows, m_size)};
+    }
+
+    constexpr reference operator[](difference_type n) const { return *(*this + n); }
+
+    constexpr chunk_iterator& operator++() noexcept { return *this += 1; }
+
+    constexpr chunk_iterator operator++(int) noexcept {
+        auto ret = *this;
+        ++*this;
+        return ret;
+    }
+
+    constexpr chunk_iterator& operator--() noexcept { return *this -= 1; }
+
+    constexpr chunk_iterator operator--(int) noexcept {
+        auto ret = *this;
+        --*this;
+        return ret;
+    }
+
+    constexpr chunk_iterator& operator+=(difference_type n) noexcept {
+        m_offset += n * m_rows;
+        return *this;
+    }
+
+    constexpr chunk_iterator& operator-=(difference_type n) noexcept {
+        return *this += -n;
+    }
+
+    friend constexpr chunk_iterator operator+(chunk_iterator it,
+                                              difference_type n) noexcept {
+        return it += n;
+    }
+
+    friend constexpr chunk_iterator operator+(difference_type n,
+                                              chunk_iterator it) noexcept {
+        return it += n;
+    }
+
+    friend constexpr chunk_iterator operator-(chunk_iterator it,
+                                              difference_type n) noexcept {
+        return it -= n;
+    }
+
+    friend constexpr difference_type operator-(const chunk_iterator& lhs,
+                                               const chunk_iterator& rhs) noexcept {
+        return (lhs.m_offset - rhs.m_offset) / lhs.m_rows;
+    }
+
+    // Chunk iterators over the same sequence only differ by their
+    // offset.
+    friend constexpr bool operator==(const chunk_iterator& lhs,
+                                     const chunk_iterator& rhs) noexcept {
+        return lhs.m_offset == rhs.m_offset;
+    }
+
+    friend constexpr bool operator!=(const chunk_iterator& lhs,
+                                     const chunk_iterator& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const chunk_iterator& lhs,
+                                    const chunk_iterator& rhs) noexcept {
+        return lhs.m_offset < rhs.m_offset;
+    }
+
+    friend constexpr bool operator>(const chunk_iterator& lhs,
+                                    const chunk_iterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const chunk_iterator& lhs,
+                                     const chunk_iterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const chunk_iterator& lhs,
+                                     const chunk_iterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+   private:
+    Iterator m_first{};
+    difference_type m_offset{};
+    difference_type m_rows{1};
+    difference_type m_size{};
+};
+
+/// chunks cuts a random access sequence (usually a zip_view) into
+/// consecutive slices of n rows, the last one being shorter when n
+/// does not divide the length of the sequence. Zipped iterators are
+/// turned into offset_iterators first, so that loops over a chunk
+/// are driven by a single induction variable. This is meant for
+/// multi-pass kernels, which can run all of their passes on a chunk
+/// while it is still cache resident:
+///
+///     for (auto&& chunk : zip::chunks(zip::zip(x, v, a), 1024)) {
+///         for (auto&& [x, v, a] : chunk) { v += a * dt; }
+///         for (auto&& [x, v, a] : chunk) { x += v * dt; }
+///     }
+///
+/// The chunks themselves form a random access sequence, which can be
+/// handed to parallel_for_each: each chunk is then scheduled as a task
+/// of its own. n must be positive.
+template <typename Sequence>
+constexpr auto chunks(Sequence&& seq, std::size_t n) {
+    using std::begin;
+    using std::end;
+    assert(n > 0);
+    auto first = begin(seq);
+    static_assert(
+        is_compatible_iterator_category_v<
+            typename std::iterator_traits<decltype(first)>::iterator_category,
+            std::random_access_iterator_tag>,
+        "chunks needs a random access sequence");
+    using iterator = chunk_iterator<decltype(impl::as_offset(first))>;
+    using difference_type = typename iterator::difference_type;
+    const auto size = static_cast<difference_type>(end(seq) - first);
+    const auto rows = static_cast<difference_type>(n);
+    const auto last = (size + rows - 1) / rows * rows;
+    auto it = impl::as_offset(std::move(first));
+    return slice<iterator>{iterator{it, 0, rows, size}, iterator{it, last, rows, size}};
+}
+
+//
+// Prefetching
+//
+
+/// prefetched wraps a random access sequence of zipped elements
+/// (usually a zip_view) into a slice of prefetch_iterators: walking it
+/// with ++ or [] prefetches, in every zipped sequence, the row Distance
+/// steps ahead of the current one, as a read or write according to
+/// Hint. This is meant for columns much larger than the last level
+/// cache, especially index indirections, whose random loads hardware
+/// prefetchers cannot anticipate:
+///
+///     for (auto&& [key, value] : zip::prefetched<16>(zip::zip(keys, values))) {
+///         ...
+///     }
+///
+/// The right distance depends on the machine and on the work done per
+/// row, it has to be tuned: too short and the misses are not hidden,
+/// too long and the lines are evicted before being used. A distance
+/// of zero prefetches nothing. Rows past the end of the sequence are
+/// never prefetched.
+template <std::size_t Distance, prefetch_hint Hint = prefetch_hint::read,
+          typename Sequence>
+constexpr auto prefetched(Sequence&& seq) {
+    using std::begin;
+    using std::end;
+    auto zipped = begin(seq);
+    static_assert(is_compatible_iterator_category_v<
+                      typename std::iterator_traits<decltype(zipped)>::iterator_category,
+                      std::random_access_iterator_tag>,
+                  "prefetched needs a random access sequence");
+    static_assert(impl::has_iterator_pack<decltype(zipped)>::value,
+                  "prefetched needs a sequence of zipped elements");
+    const auto size = end(seq) - zipped;
+    const auto first = impl::as_offset(std::move(zipped));
+    auto make = [](auto&&... its) {
+        return prefetch_iterator<Distance, Hint, std::decay_t<decltype(its)>...>{its...};
+    };
+    auto it_begin = std::apply(make, first.iterators());
+    it_begin.m_offset = first.m_offset;
+    it_begin.m_size = first.m_offset + size;
+    auto it_end = it_begin;
+    it_end.m_offset = it_begin.m_size;
+    return slice<decltype(it_begin)>{it_begin, it_end};
+}
+
+//
+// Fields
+//
+
+/// member_iterator walks a data member of consecutive Struct objects,
+/// e.g. one field of an array of structs: a random access column
+/// whose stride, sizeof(Struct), is known at compile time. So is the
+/// member itself when given as Pointer, otherwise it is picked at
+/// runtime: compilers then cannot tell that members of the same
+/// struct are interleaved, and kernels over several of them usually
+/// do not vectorise.
+template <typename Struct, typename Member,
+          Member std::remove_cv_t<Struct>::*Pointer = nullptr>
+class member_iterator {
+   public:
+    using member_pointer = Member std::remove_cv_t<Struct>::*;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<Member>;
+    using difference_type = std::ptrdiff_t;
+    using reference = decltype(std::declval<Struct&>().*std::declval<member_pointer>());
+    using pointer = std::add_pointer_t<reference>;
+
+    constexpr member_iterator() noexcept = default;
+
+    constexpr member_iterator(Struct* object, member_pointer member = Pointer) noexcept
+        : m_object{object}, m_member{member} {}
+
+    /// The struct the iterator points to.
+    constexpr Struct* object() const noexcept { return m_object; }
+
+    constexpr reference operator*() const noexcept { return (*this)[0]; }
+
+    constexpr reference operator[](difference_type n) const noexcept {
+        if constexpr (Pointer != nullptr) {
+            return m_object[n].*Pointer;
+        } else {
+            return m_object[n].*m_member;
+        }
+    }
+
+    constexpr member_iterator& operator++() noexcept { return *this += 1; }
+
+    constexpr member_iterator operator++(int) noexcept {
+        auto ret = *this;
+        ++*this;
+        return ret;
+    }
+
+    constexpr member_iterator& operator--() noexcept { return *this -= 1; }
+
+    constexpr member_iterator operator--(int) noexcept {
+        auto ret = *this;
+        --*this;
+        return ret;
+    }
+
+    constexpr member_iterator& operator+=(difference_type n) noexcept {
+        m_object += n;
+        return *this;
+    }
+
+    constexpr member_iterator& operator-=(difference_type n) noexcept {
+        m_object -= n;
+        return *this;
+    }
+
+    friend constexpr member_iterator operator+(member_iterator it,
+                                               difference_type n) noexcept {
+        return it += n;
+    }
+
+    friend constexpr member_iterator operator+(difference_type n,
+                                               member_iterator it) noexcept {
+        return it += n;
+    }
+
+    friend constexpr member_iterator operator-(member_iterator it,
+                                               difference_type n) noexcept {
+        return it -= n;
+    }
+
+    friend constexpr difference_type operator-(const member_iterator& lhs,
+                                               const member_iterator& rhs) noexcept {
+        return lhs.m_object - rhs.m_object;
+    }
+
+    // Iterators over the same member only differ by their object.
+    friend constexpr bool operator==(const member_iterator& lhs,
+                                     const member_iterator& rhs) noexcept {
+        return lhs.m_object == rhs.m_object;
+    }
+
+    friend constexpr bool operator!=(const member_iterator& lhs,
+                                     const member_iterator& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const member_iterator& lhs,
+                                    const member_iterator& rhs) noexcept {
+        return lhs.m_object < rhs.m_object;
+    }
+
+    friend constexpr bool operator>(const member_iterator& lhs,
+                                    const member_iterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const member_iterator& lhs,
+                                     const member_iterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const member_iterator& lhs,
+                                     const member_iterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+   private:
+    Struct* m_object = nullptr;
+    member_pointer m_member = nullptr;
+};
+
+namespace impl {
+
+template <typename MemberPointer>
+struct member_type;
+
+template <typename Member, typename Struct>
+struct member_type<Member Struct::*> {
+    using type = Member;
+};
+
+}  // namespace impl
+
+/// fields zips data members of a contiguous array of structs as if
+/// they were columns, without transposing anything:
+///
+///     std::vector<particle> ps = ...;
+///     for (auto&& [x, v] : zip::fields(ps, &particle::x, &particle::v)) {
+///         x += v * dt;
+///     }
+///
+/// The result is a random access slice of offset_iterators over
+/// member_iterators, so that the very same kernels (and algorithms:
+/// chunks, parallel_for_each, reduce...) run on AoS and SoA data.
+/// Loads and stores are strided though: kernels touching most of
+/// the members of each struct are the ones that benefit the most.
+template <typename Sequence, typename... Members>
+constexpr auto fields(Sequence&& aos, Members... members) {
+    static_assert(is_contiguous_sequence_v<std::remove_reference_t<Sequence>>,
+                  "fields needs a contiguous sequence of structs");
+    static_assert(sizeof...(Members) > 0, "fields needs at least one member");
+    static_assert((std::is_member_object_pointer_v<Members> && ...),
+                  "fields needs pointers to data members");
+    using struct_type = std::remove_pointer_t<decltype(std::data(aos))>;
+    auto first = make_iterator(
+        offset_iterator_tag{},
+        member_iterator<struct_type, typename impl::member_type<Members>::type>{
+            std::data(aos), members}...);
+    auto last = first + static_cast<std::ptrdiff_t>(std::size(aos));
+    return slice<decltype(first)>{first, last};
+}
+
+/// Same as above, with the members given at compile time:
+///
+///     zip::fields<&particle::x, &particle::v>(ps)
+///
+/// This spelling should be preferred for kernels touching several
+/// members: knowing where each member lies within the struct, the
+/// compiler can vectorise loads and stores with shuffles.
+template <auto... Members, typename Sequence>
+constexpr auto fields(Sequence&& aos) {
+    static_assert(is_contiguous_sequence_v<std::remove_reference_t<Sequence>>,
+                  "fields needs a contiguous sequence of structs");
+    static_assert(sizeof...(Members) > 0, "fields needs at least one member");
+    static_assert((std::is_member_object_pointer_v<decltype(Members)> && ...),
+                  "fields needs pointers to data members");
+    using struct_type = std::remove_pointer_t<decltype(std::data(aos))>;
+    auto first = make_iterator(
+        offset_iterator_tag{},
+        member_iterator<struct_type, typename impl::member_type<decltype(Members)>::type,
+                        Members>{std::data(aos)}...);
+    auto last = first + static_cast<std::ptrdiff_t>(std::size(aos));
+    return slice<decltype(first)>{first, last};
+}
+
 }  // namespace zip
 
+namespace std {
+
+template <typename... Ts>
+struct tuple_size<zip::value_tuple<Ts...>>
+    : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t I, typename... Ts>
+struct tuple_element<I, zip::value_tuple<Ts...>> {
+    using type = std::tuple_element_t<I, std::tuple<Ts...>>;
+};
+
+template <typename... Refs>
+struct tuple_size<zip::reference_tuple<Refs...>>
+    : std::integral_constant<std::size_t, sizeof...(Refs)> {};
+
+template <std::size_t I, typename... Refs>
+struct tuple_element<I, zip::reference_tuple<Refs...>> {
+    using type = std::tuple_element_t<I, std::tuple<Refs...>>;
+};
+
+template <std::size_t Width, typename... Ts>
+struct tuple_size<zip::batch<Width, Ts...>>
+    : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t I, std::size_t Width, typename... Ts>
+struct tuple_element<I, zip::batch<Width, Ts...>> {
+    using type = std::array<zip::nth_type_t<I, Ts...>, Width>;
+};
+
+#if defined(__cpp_lib_ranges)
+
+// The common reference of proxies (and of a proxy and a value_tuple)
+// refers to the common reference of each pair of elements, which is
+// what makes zipped iterators C++20 iterators.
+template <typename... Refs, typename... Ts, template <typename> typename RQual,
+          template <typename> typename TQual>
+    requires(sizeof...(Refs) == sizeof...(Ts))
+struct basic_common_reference<zip::reference_tuple<Refs...>, zip::value_tuple<Ts...>,
+                              RQual, TQual> {
+    using type =
+        zip::reference_tuple<zip::impl::common_element_t<RQual<Refs>, TQual<Ts>>...>;
+};
+
+template <typename... Ts, typename... Refs, template <typename> typename TQual,
+          template <typename> typename RQual>
+    requires(sizeof...(Refs) == sizeof...(Ts))
+struct basic_common_reference<zip::value_tuple<Ts...>, zip::reference_tuple<Refs...>,
+                              TQual, RQual> {
+    using type =
+        zip::reference_tuple<zip::impl::common_element_t<TQual<Ts>, RQual<Refs>>...>;
+};
+
+template <typename... Refs, typename... Others, template <typename> typename RQual,
+          template <typename> typename OQual>
+    requires(sizeof...(Refs) == sizeof...(Others))
+struct basic_common_reference<zip::reference_tuple<Refs...>,
+                              zip::reference_tuple<Others...>, RQual, OQual> {
+    using type =
+        zip::reference_tuple<zip::impl::common_element_t<RQual<Refs>, OQual<Others>>...>;
+};
+
+// zip_views are views, cheap to copy, and borrowed ranges: they only
+// refer to the sequences they zip, which are lvalues, so that their
+// iterators never dangle along with them.
+template <typename IteratorCategory, typename... Sequences>
+inline constexpr bool ranges::enable_view<zip::zip_view<IteratorCategory, Sequences...>> =
+    true;
+
+template <typename IteratorCategory, typename... Sequences>
+inline constexpr bool
+    ranges::enable_borrowed_range<zip::zip_view<IteratorCategory, Sequences...>> = true;
+
+#endif
+
+}  // namespace std
+
 #endif
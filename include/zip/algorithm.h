@@ -0,0 +1,741 @@
+#ifndef ZIP_ALGORITHM_H_INCLUDED_20261017
+#define ZIP_ALGORITHM_H_INCLUDED_20261017
+
+#include <zip.h>
+#include <zip/isa.h>
+#include <zip/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zip {
+
+namespace impl {
+
+inline constexpr std::size_t radix_bits = 8;
+inline constexpr std::size_t radix_buckets = std::size_t{1} << radix_bits;
+
+// radix_key maps an integral (or enum) key to an unsigned integer of
+// the same width that sorts the same way: signed keys just get their
+// sign bit flipped.
+template <typename T>
+constexpr auto radix_key(T value) noexcept {
+    if constexpr (std::is_enum_v<T>) {
+        return radix_key(static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return static_cast<unsigned char>(value);
+    } else {
+        static_assert(std::is_integral_v<T>, "radix_sort keys must be integral or enums");
+        using key_type = std::make_unsigned_t<T>;
+        if constexpr (std::is_signed_v<T>) {
+            constexpr auto sign = static_cast<key_type>(
+                key_type{1} << (std::numeric_limits<key_type>::digits - 1));
+            return static_cast<key_type>(static_cast<key_type>(value) ^ sign);
+        } else {
+            return static_cast<key_type>(value);
+        }
+    }
+}
+
+template <typename T>
+using radix_key_t = decltype(radix_key(std::declval<T>()));
+
+template <typename Iterator, std::size_t I>
+using column_value_t = std::remove_cv_t<
+    std::remove_reference_t<decltype(std::get<I>(*std::declval<Iterator>()))>>;
+
+// column_begin returns the iterator over the I-th column at the
+// position of the zipped offset_iterator it.
+template <std::size_t I, typename Iterator>
+constexpr auto column_begin(const Iterator& it) {
+    return std::get<I>(it.iterators()) + it.m_offset;
+}
+
+// assign_row sets to[i] from from[j], moving the element when Move.
+template <bool Move, typename To, typename From>
+void assign_row(const To& to, std::ptrdiff_t i, const From& from, std::ptrdiff_t j) {
+    if constexpr (Move) {
+        to[i] = std::move(from[j]);
+    } else {
+        to[i] = from[j];
+    }
+}
+
+// prefetch hints the caches that the element at it is about to be
+// read. Elements computed on the fly have nothing to prefetch.
+template <typename Iterator>
+void prefetch([[maybe_unused]] const Iterator& it) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (std::is_lvalue_reference_v<decltype(*it)>) {
+        __builtin_prefetch(std::addressof(*it));
+    }
+#endif
+}
+
+// Gathers read elements all over their source: the elements that
+// many positions ahead get prefetched, so that their cache misses
+// overlap with the copy of the current ones.
+inline constexpr std::ptrdiff_t gather_prefetch_distance = 16;
+
+// gather_column sets to[i] to from[index[i]] for i in [lo, hi).
+template <bool Move, typename From, typename To, typename IndexIterator>
+void gather_column(const From& from, const To& to, const IndexIterator& index,
+                   std::ptrdiff_t lo, std::ptrdiff_t hi) {
+    auto i = lo;
+    for (; i + gather_prefetch_distance < hi; ++i) {
+        prefetch(from + static_cast<std::ptrdiff_t>(index[i + gather_prefetch_distance]));
+        assign_row<Move>(to, i, from, static_cast<std::ptrdiff_t>(index[i]));
+    }
+    for (; i < hi; ++i) {
+        assign_row<Move>(to, i, from, static_cast<std::ptrdiff_t>(index[i]));
+    }
+}
+
+// radix_sort_key sorts the (key, index) pairs of the I-th column by
+// key, one radix_bits digit at a time, starting from the current
+// permutation. Each pass builds one histogram per chunk, so that the
+// chunks can then scatter their pairs concurrently, and in order.
+template <std::size_t I, typename Index, typename Iterator>
+void radix_sort_key(thread_pool& pool, const Iterator& first, std::vector<Index>& perm,
+                    std::vector<Index>& perm_tmp) {
+    using key_type = radix_key_t<column_value_t<Iterator, I>>;
+    using counts_type = std::array<Index, radix_buckets>;
+
+    const auto size = std::size(perm);
+    const auto chunks = chunk_count(pool, size);
+    std::vector<key_type> keys(size);
+    std::vector<key_type> keys_tmp(size);
+
+    parallel_for(pool, size, [&](std::size_t lo, std::size_t hi) {
+        for (auto i = lo; i < hi; ++i) {
+            keys[i] = radix_key(
+                std::get<I>(first[static_cast<std::ptrdiff_t>(perm[i])]));
+        }
+    });
+
+    constexpr std::size_t key_bits = std::numeric_limits<key_type>::digits;
+    std::vector<counts_type> counts(chunks);
+    for (std::size_t shift = 0; shift < key_bits; shift += radix_bits) {
+        const auto digit = [shift](key_type key) {
+            return static_cast<std::size_t>(key >> shift) & (radix_buckets - 1);
+        };
+
+        pool.run(chunks, [&](std::size_t c) {
+            auto& count = counts[c];
+            count.fill(0);
+            for (auto i = size * c / chunks, last = size * (c + 1) / chunks; i < last;
+                 ++i) {
+                ++count[digit(keys[i])];
+            }
+        });
+
+        // Turn counts into scatter offsets, ordered by digit first and
+        // by chunk then. Passes where all the keys share the same digit
+        // would leave everything in place: skip them.
+        bool trivial = false;
+        Index offset = 0;
+        for (std::size_t d = 0; d < radix_buckets; ++d) {
+            const auto first_offset = offset;
+            for (auto&& count : counts) {
+                offset = static_cast<Index>(offset + std::exchange(count[d], offset));
+            }
+            trivial = trivial || static_cast<std::size_t>(offset - first_offset) == size;
+        }
+        if (trivial) {
+            continue;
+        }
+
+        const auto src = make_iterator(offset_iterator_tag{}, keys.data(), perm.data());
+        const auto dst =
+            make_iterator(offset_iterator_tag{}, keys_tmp.data(), perm_tmp.data());
+        pool.run(chunks, [&](std::size_t c) {
+            auto& count = counts[c];
+            for (auto i = size * c / chunks, last = size * (c + 1) / chunks; i < last;
+                 ++i) {
+                auto& pos = count[digit(keys[i])];
+                dst[static_cast<std::ptrdiff_t>(pos++)] =
+                    src[static_cast<std::ptrdiff_t>(i)];
+            }
+        });
+        keys.swap(keys_tmp);
+        perm.swap(perm_tmp);
+    }
+}
+
+// Keys are sorted least significant first: as every pass is stable,
+// the last one (the first key) ends up being the most significant.
+template <typename Index, typename Iterator, std::size_t Key, std::size_t... Keys>
+void radix_sort_keys(thread_pool& pool, const Iterator& first, std::vector<Index>& perm,
+                     std::vector<Index>& perm_tmp) {
+    if constexpr (sizeof...(Keys) > 0) {
+        radix_sort_keys<Index, Iterator, Keys...>(pool, first, perm, perm_tmp);
+    }
+    radix_sort_key<Key>(pool, first, perm, perm_tmp);
+}
+
+// permute_column sets the I-th column element at position i to the
+// one at position perm[i], going through a temporary buffer.
+template <std::size_t I, typename Iterator, typename IndexIterator>
+void permute_column(thread_pool& pool, const Iterator& first, const IndexIterator& perm,
+                    std::size_t size) {
+    using value_type = column_value_t<Iterator, I>;
+    static_assert(std::is_default_constructible_v<value_type>,
+                  "permutations need default constructible columns");
+    std::vector<value_type> tmp(size);
+    const auto column = column_begin<I>(first);
+    parallel_for(pool, size, [&](std::size_t lo, std::size_t hi) {
+        gather_column<true>(column, tmp.data(), perm, static_cast<std::ptrdiff_t>(lo),
+                            static_cast<std::ptrdiff_t>(hi));
+    });
+    parallel_for(pool, size, [&](std::size_t lo, std::size_t hi) {
+        for (auto i = lo; i < hi; ++i) {
+            column[static_cast<std::ptrdiff_t>(i)] = std::move(tmp[i]);
+        }
+    });
+}
+
+template <typename Iterator, typename IndexIterator, std::size_t... Indexes>
+void permute_columns(thread_pool& pool, const Iterator& first, const IndexIterator& perm,
+                     std::size_t size, std::index_sequence<Indexes...>) {
+    (permute_column<Indexes>(pool, first, perm, size), ...);
+}
+
+template <typename Index, std::size_t... Keys, typename Iterator>
+void radix_sort(thread_pool& pool, const Iterator& first, std::size_t size) {
+    std::vector<Index> perm(size);
+    std::vector<Index> perm_tmp(size);
+    std::iota(std::begin(perm), std::end(perm), Index{0});
+    radix_sort_keys<Index, Iterator, Keys...>(pool, first, perm, perm_tmp);
+    permute_columns(
+        pool, first, perm.data(), size,
+        std::make_index_sequence<std::tuple_size_v<typename Iterator::pack_type>>{});
+}
+
+template <typename Iterator>
+struct is_static_member_iterator : std::false_type {};
+
+template <typename Struct, typename Member, Member std::remove_cv_t<Struct>::*Pointer>
+struct is_static_member_iterator<member_iterator<Struct, Member, Pointer>>
+    : std::bool_constant<Pointer != nullptr> {};
+
+// with_shared_object calls f with the column iterators its, unless
+// they all walk compile-time members of the very same structs: f
+// then gets them rebuilt from a single pointer, so that compilers
+// see the members are interleaved and vectorise their accesses with
+// shuffles.
+template <typename... Iterators, typename F>
+void with_shared_object(const std::tuple<Iterators...>& its, F&& f) {
+    if constexpr ((is_static_member_iterator<Iterators>::value && ...)) {
+        auto* object = std::get<0>(its).object();
+        if constexpr ((std::is_same_v<decltype(object),
+                                      decltype(std::declval<Iterators>().object())> &&
+                       ...)) {
+            const auto shared = std::apply(
+                [object](auto&&... it) { return ((it.object() == object) && ...); }, its);
+            if (shared) {
+                f(std::tuple<Iterators...>{Iterators{object}...});
+                return;
+            }
+        }
+    }
+    f(its);
+}
+
+// copy_rows copies rows [lo, hi) one after the other, going through
+// the column iterators rather than reference_tuple proxies so that
+// the loop body is nothing but plain loads and stores.
+template <typename Source, typename Destination, std::size_t... Indexes>
+void copy_rows(const Source& src, const Destination& dst, std::size_t lo, std::size_t hi,
+               std::index_sequence<Indexes...>) {
+    with_shared_object(std::make_tuple(column_begin<Indexes>(src)...), [&](auto from) {
+        with_shared_object(std::make_tuple(column_begin<Indexes>(dst)...), [&](auto to) {
+            for (auto i = static_cast<std::ptrdiff_t>(lo);
+                 i < static_cast<std::ptrdiff_t>(hi); ++i) {
+                ((std::get<Indexes>(to)[i] = std::get<Indexes>(from)[i]), ...);
+            }
+        });
+    });
+}
+
+// copy_columns copies the rows of a random access zipped sequence to
+// another one with the same number of columns, e.g. an array of
+// structs zipped by fields() and a zip_view of columns. Every column
+// moves in the same loop, so that structs are read or written whole,
+// one cache line after the other.
+template <typename Source, typename Destination>
+void copy_columns(thread_pool& pool, Source&& src, Destination&& dst) {
+    using std::begin;
+    using std::end;
+    const auto from = as_offset(begin(src));
+    const auto to = as_offset(begin(dst));
+    using source_pack = typename decltype(from)::pack_type;
+    using destination_pack = typename decltype(to)::pack_type;
+    static_assert(std::tuple_size_v<source_pack> == std::tuple_size_v<destination_pack>,
+                  "source and destination must have the same number of columns");
+    const auto size = std::min(static_cast<std::ptrdiff_t>(end(src) - begin(src)),
+                               static_cast<std::ptrdiff_t>(end(dst) - begin(dst)));
+    parallel_for(pool, size, [&](auto lo, auto hi) {
+        copy_rows(from, to, static_cast<std::size_t>(lo), static_cast<std::size_t>(hi),
+                  std::make_index_sequence<std::tuple_size_v<source_pack>>{});
+    });
+}
+
+// Filters run block by block: the predicate is first evaluated on a
+// whole block into flags, in a loop that vectorises, then the rows
+// are packed. Dense blocks store every row up to the last selected
+// one, the write position only moving past the selected ones, so that
+// rows not selected get overwritten; sparse blocks pack the indexes of
+// the selected rows first, and then only copy these. Neither has any
+// branch depending on the data, whatever the selectivity.
+inline constexpr std::size_t filter_block_size = 256;
+
+using filter_index = std::uint16_t;
+
+template <typename Iterator, typename Predicate>
+std::size_t flag_rows(const Iterator& first, std::ptrdiff_t lo, std::size_t n,
+                      Predicate& pred, std::uint8_t* flags) {
+    std::size_t count = 0;
+    for (std::size_t j = 0; j < n; ++j) {
+        flags[j] = static_cast<bool>(pred(first[lo + static_cast<std::ptrdiff_t>(j)]));
+        count += flags[j];
+    }
+    return count;
+}
+
+// pack_dense stores the n rows of from to to, each one right after
+// the last selected one. Trailing rows that are not selected are left
+// out, so that nothing gets written past the selected rows.
+template <bool Move, typename From, typename To, std::size_t... Indexes>
+void pack_dense(const From& from, const To& to, const std::uint8_t* flags, std::size_t n,
+                std::index_sequence<Indexes...>) {
+    while (n > 0 && !flags[n - 1]) {
+        --n;
+    }
+    std::ptrdiff_t at = 0;
+    for (std::size_t j = 0; j < n; ++j) {
+        (assign_row<Move>(std::get<Indexes>(to), at, std::get<Indexes>(from),
+                          static_cast<std::ptrdiff_t>(j)),
+         ...);
+        at += flags[j];
+    }
+}
+
+template <bool Move, typename From, typename To, std::size_t... Indexes>
+void pack_sparse(const From& from, const To& to, const filter_index* selection,
+                 std::size_t count, std::index_sequence<Indexes...>) {
+    for (std::size_t t = 0; t < count; ++t) {
+        const auto j = static_cast<std::ptrdiff_t>(selection[t]);
+        (assign_row<Move>(std::get<Indexes>(to), static_cast<std::ptrdiff_t>(t),
+                          std::get<Indexes>(from), j),
+         ...);
+    }
+}
+
+// filter_rows writes the rows of src[lo, size) passing pred to dst,
+// from position at, and stops once dst is full. Returns the position
+// past the last row written. Rows are only moved in place, to
+// strictly lower positions. Dense packing needs room for all the
+// selected rows of a block, the block filling dst is packed sparsely.
+template <bool Move, typename Source, typename Destination, typename Predicate,
+          std::size_t... Indexes>
+std::ptrdiff_t filter_rows(const Source& src, std::ptrdiff_t lo, std::ptrdiff_t size,
+                           const Destination& dst, std::ptrdiff_t at,
+                           std::ptrdiff_t capacity, Predicate& pred,
+                           std::index_sequence<Indexes...> indexes) {
+    std::array<std::uint8_t, filter_block_size> flags;
+    std::array<filter_index, filter_block_size> selection;
+    for (; lo < size && at < capacity; lo += std::ptrdiff_t{filter_block_size}) {
+        const auto n = std::min(filter_block_size, static_cast<std::size_t>(size - lo));
+        auto count = flag_rows(src, lo, n, pred, flags.data());
+        const auto from = std::make_tuple((column_begin<Indexes>(src) + lo)...);
+        const auto to = std::make_tuple((column_begin<Indexes>(dst) + at)...);
+        if (2 * count >= n && at + static_cast<std::ptrdiff_t>(count) <= capacity) {
+            pack_dense<Move>(from, to, flags.data(), n, indexes);
+        } else {
+            std::size_t selected = 0;
+            for (std::size_t j = 0; j < n; ++j) {
+                selection[selected] = static_cast<filter_index>(j);
+                selected += flags[j];
+            }
+            count = std::min(count, static_cast<std::size_t>(capacity - at));
+            pack_sparse<Move>(from, to, selection.data(), count, indexes);
+        }
+        at += static_cast<std::ptrdiff_t>(count);
+    }
+    return at;
+}
+
+// This gather_column runs over [0, size), on the threads of pool.
+template <bool Move, typename From, typename To, typename IndexIterator>
+void gather_column(thread_pool& pool, const From& from, const To& to,
+                   const IndexIterator& index, std::ptrdiff_t size) {
+    parallel_for(pool, size, [&](std::ptrdiff_t lo, std::ptrdiff_t hi) {
+        dispatch([&] { gather_column<Move>(from, to, index, lo, hi); });
+    });
+}
+
+// gather_columns runs gather_column over [0, size) for each column
+// in turn, on the threads of pool. Gathering a column at a time keeps
+// the random reads within a single array, which is much kinder to
+// the TLB and to the caches than reading every column of each row.
+template <typename Source, typename Destination, typename IndexIterator,
+          std::size_t... Indexes>
+void gather_columns(thread_pool& pool, const Source& src, const Destination& dst,
+                    const IndexIterator& index, std::ptrdiff_t size,
+                    std::index_sequence<Indexes...>) {
+    (gather_column<false>(pool, column_begin<Indexes>(src), column_begin<Indexes>(dst),
+                          index, size),
+     ...);
+}
+
+// for_each aligns the rows of its main loop on this many bytes in
+// the column driving it, enough for any vector width.
+inline constexpr std::size_t for_each_alignment = 64;
+
+template <typename Iterator, std::size_t I>
+using column_iterator_t =
+    std::tuple_element_t<I, std::remove_cv_t<std::remove_reference_t<
+                                decltype(std::declval<const Iterator&>().iterators())>>>;
+
+template <typename Iterator, std::size_t I>
+inline constexpr bool is_written_column_v = !std::is_const_v<
+    std::remove_reference_t<decltype(std::get<I>(*std::declval<Iterator>()))>>;
+
+// aligned_column picks the column whose alignment drives for_each:
+// the first one that can be written, the output of the kernel, or
+// else the one with the widest elements.
+template <typename Iterator, std::size_t... Indexes>
+constexpr std::size_t aligned_column(std::index_sequence<Indexes...>) {
+    constexpr bool written[] = {is_written_column_v<Iterator, Indexes>...};
+    constexpr std::size_t sizes[] = {sizeof(column_value_t<Iterator, Indexes>)...};
+    std::size_t widest = 0;
+    for (std::size_t i = 0; i < sizeof...(Indexes); ++i) {
+        if (written[i]) {
+            return i;
+        }
+        if (sizes[i] > sizes[widest]) {
+            widest = i;
+        }
+    }
+    return widest;
+}
+
+template <std::size_t Alignment, typename T>
+T* assume_aligned(T* ptr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<T*>(__builtin_assume_aligned(ptr, Alignment));
+#else
+    return ptr;
+#endif
+}
+
+// aligned_rows returns the offset_iterator (or no_alias_iterator)
+// walking the same rows as it, whose Column-th column the compiler is
+// told is aligned.
+template <std::size_t Column, typename Iterator, std::size_t... Indexes>
+auto aligned_rows(const Iterator& it, std::index_sequence<Indexes...>) {
+    using category = std::conditional_t<is_no_alias_iterator_v<Iterator>,
+                                        no_alias_iterator_tag, offset_iterator_tag>;
+    const auto aligned =
+        assume_aligned<for_each_alignment>(column_begin<Column>(it));
+    return make_iterator(category{},
+                         [&](auto column) {
+                             if constexpr (decltype(column)::value == Column) {
+                                 return aligned;
+                             } else {
+                                 return column_begin<decltype(column)::value>(it);
+                             }
+                         }(std::integral_constant<std::size_t, Indexes>{})...);
+}
+
+// each_row calls f on the first size rows from the offset_iterator
+// it, which are walked through no_alias_rows for no_alias columns.
+template <typename Iterator, typename UnaryOp>
+void each_row(const Iterator& it, std::ptrdiff_t size, UnaryOp& f) {
+    if constexpr (is_no_alias_iterator_v<Iterator>) {
+        no_alias_rows(it, size, [&f](const auto& rows, std::ptrdiff_t i) { f(rows[i]); });
+    } else {
+        for (std::ptrdiff_t i = 0; i < size; ++i) {
+            f(it[i]);
+        }
+    }
+}
+
+// for_each_rows is the loop of for_each, over the size rows from the
+// offset_iterator first.
+template <typename Iterator, typename UnaryOp>
+void for_each_rows(const Iterator& first, std::ptrdiff_t size, UnaryOp& f) {
+    using indexes =
+        std::make_index_sequence<std::tuple_size_v<typename Iterator::pack_type>>;
+    constexpr auto column = aligned_column<Iterator>(indexes{});
+    using element = column_value_t<Iterator, column>;
+    constexpr auto alignment = for_each_alignment;
+    std::ptrdiff_t i = 0;
+    if constexpr (std::is_pointer_v<column_iterator_t<Iterator, column>> &&
+                  alignment % sizeof(element) == 0) {
+        constexpr auto lanes = static_cast<std::ptrdiff_t>(alignment / sizeof(element));
+        const auto address =
+            reinterpret_cast<std::uintptr_t>(column_begin<column>(first));
+        if (address % sizeof(element) == 0) {
+            const auto misalignment = (alignment - address % alignment) % alignment;
+            const auto peel = std::min(
+                static_cast<std::ptrdiff_t>(misalignment / sizeof(element)), size);
+            each_row(first, peel, f);
+            const auto body = (size - peel) / lanes * lanes;
+            // Only then is first + peel known to be aligned.
+            if (body > 0) {
+                each_row(aligned_rows<column>(first + peel, indexes{}), body, f);
+            }
+            i = peel + body;
+        }
+    }
+    each_row(first + i, size - i, f);
+}
+
+}  // namespace impl
+
+/// for_each applies f to every row of the random access zipped
+/// sequence seq (usually a zip_view), in order, and returns f, just
+/// like std::for_each. The loop is split in three so that its main
+/// part runs on aligned rows of one column, the output of the kernel
+/// (the first column that can be written) or else the column with the
+/// widest elements: a prologue of single rows, up to the first row
+/// aligned on a cache line in that column, a main body over blocks of
+/// a cache line worth of rows, each one of them starting aligned, and
+/// an epilogue with the remaining rows. Column addresses are looked
+/// at once, before the loop, and only contiguous columns get aligned;
+/// otherwise, and for elements whose size does not divide a cache
+/// line, this is a plain loop. Over a zip(no_alias, ...) view, the
+/// loop is also free of runtime overlap checks.
+template <typename Sequence, typename UnaryOp>
+UnaryOp for_each(Sequence&& seq, UnaryOp f) {
+    using std::begin;
+    using std::end;
+    using iterator_category =
+        typename std::iterator_traits<decltype(begin(seq))>::iterator_category;
+    static_assert(
+        std::is_convertible_v<iterator_category, std::random_access_iterator_tag>,
+        "for_each needs a random access sequence");
+    const auto size = static_cast<std::ptrdiff_t>(end(seq) - begin(seq));
+    impl::dispatch([&] { impl::for_each_rows(impl::as_offset(begin(seq)), size, f); });
+    return f;
+}
+
+/// scatter_to_columns copies the rows of an array of structs, zipped
+/// by fields(), to the columns of a random access zipped sequence
+/// (e.g. a zip_view or a soa_vector), column I getting the I-th
+/// field:
+///
+///     zip::soa_vector<float, float> soa(std::size(ps));
+///     zip::scatter_to_columns(zip::fields<&P::x, &P::y>(ps), soa);
+///
+/// As many rows as the shortest of the two holds get copied, spread
+/// over the threads of the given pool. Each row is copied column by
+/// column through the underlying iterators, with no proxy in between;
+/// when the fields are given at compile time, the compiler also knows
+/// how they are interleaved and vectorises the copy with shuffles.
+template <typename Source, typename Destination>
+void scatter_to_columns(thread_pool& pool, Source&& aos, Destination&& soa) {
+    impl::copy_columns(pool, std::forward<Source>(aos), std::forward<Destination>(soa));
+}
+
+template <typename Source, typename Destination>
+void scatter_to_columns(Source&& aos, Destination&& soa) {
+    scatter_to_columns(default_thread_pool(), std::forward<Source>(aos),
+                       std::forward<Destination>(soa));
+}
+
+/// gather_from_columns is the converse of scatter_to_columns: it
+/// copies the columns of a random access zipped sequence to the
+/// fields of an array of structs, zipped by fields().
+template <typename Source, typename Destination>
+void gather_from_columns(thread_pool& pool, Source&& soa, Destination&& aos) {
+    impl::copy_columns(pool, std::forward<Source>(soa), std::forward<Destination>(aos));
+}
+
+template <typename Source, typename Destination>
+void gather_from_columns(Source&& soa, Destination&& aos) {
+    gather_from_columns(default_thread_pool(), std::forward<Source>(soa),
+                        std::forward<Destination>(aos));
+}
+
+/// radix_sort sorts a random access sequence of zipped elements
+/// (usually a zip_view) by its integral (or enum) columns Keys...,
+/// the first one being the most significant, and permutes all the
+/// other columns along:
+///
+///     zip::radix_sort<1, 0>(zip::zip(x, year, id));  // by year, then x
+///
+/// The sort is stable and runs LSD radix passes over 8-bit digits:
+/// each key column is copied once into a buffer of (key, index) pairs
+/// that get scattered pass after pass, then every column is permuted
+/// just once at the very end. Histograms and scatters are split in
+/// chunks run on the threads of the given pool.
+template <std::size_t... Keys, typename Sequence>
+void radix_sort(thread_pool& pool, Sequence&& seq) {
+    static_assert(sizeof...(Keys) > 0, "radix_sort needs at least one key column");
+    using std::begin;
+    using std::end;
+    using iterator_category =
+        typename std::iterator_traits<decltype(begin(seq))>::iterator_category;
+    static_assert(
+        std::is_convertible_v<iterator_category, std::random_access_iterator_tag>,
+        "radix_sort needs a random access sequence");
+    const auto size = end(seq) - begin(seq);
+    if (size <= 1) {
+        return;
+    }
+    const auto first = impl::as_offset(begin(seq));
+    const auto total = static_cast<std::size_t>(size);
+    // Narrower indexes halve the memory traffic of the scatter passes
+    if (total <= std::numeric_limits<std::uint32_t>::max()) {
+        impl::radix_sort<std::uint32_t, Keys...>(pool, first, total);
+    } else {
+        impl::radix_sort<std::size_t, Keys...>(pool, first, total);
+    }
+}
+
+template <std::size_t... Keys, typename Sequence>
+void radix_sort(Sequence&& seq) {
+    radix_sort<Keys...>(default_thread_pool(), std::forward<Sequence>(seq));
+}
+
+/// filter_copy copies the rows of the random access zipped sequence
+/// in (usually a zip_view) for which pred returns true to out, which
+/// must have the same number of columns, in order, up to the end of
+/// out. Returns the number of rows written, the rows of out past them
+/// being left untouched. Like std::copy_if, pred gets each row as a
+/// tuple of references:
+///
+///     auto n = zip::filter_copy(zip::zip(id, weight), [](auto&& row) {
+///         return std::get<1>(row) > 0.5f;
+///     }, zip::zip(selected_id, selected_weight));
+///
+/// Rows are processed in blocks: pred is evaluated on all the rows of
+/// a block first, the selected ones are then packed to the left, and
+/// each column is copied in turn. No branch depends on pred, so that
+/// the cost does not depend on the selectivity nor on how selected
+/// rows are distributed.
+template <typename Sequence, typename Predicate, typename Output>
+std::size_t filter_copy(Sequence&& in, Predicate pred, Output&& out) {
+    using std::begin;
+    using std::end;
+    const auto src = impl::as_offset(begin(in));
+    const auto dst = impl::as_offset(begin(out));
+    using source_pack = typename decltype(src)::pack_type;
+    using destination_pack = typename decltype(dst)::pack_type;
+    static_assert(std::tuple_size_v<source_pack> == std::tuple_size_v<destination_pack>,
+                  "source and destination must have the same number of columns");
+    const auto size = static_cast<std::ptrdiff_t>(end(in) - begin(in));
+    const auto capacity = static_cast<std::ptrdiff_t>(end(out) - begin(out));
+    return static_cast<std::size_t>(impl::dispatch([&] {
+        return impl::filter_rows<false>(
+            src, 0, size, dst, 0, capacity, pred,
+            std::make_index_sequence<std::tuple_size_v<source_pack>>{});
+    }));
+}
+
+/// compact is the in-place filter_copy: it moves the rows of seq for
+/// which pred returns true to the front of seq, in order, and returns
+/// their count. Rows past that count are left in a valid but
+/// unspecified state, as by std::remove_if.
+template <typename Sequence, typename Predicate>
+std::size_t compact(Sequence&& seq, Predicate pred) {
+    using std::begin;
+    using std::end;
+    const auto first = impl::as_offset(begin(seq));
+    using pack = typename decltype(first)::pack_type;
+    const auto size = static_cast<std::ptrdiff_t>(end(seq) - begin(seq));
+    // Leading rows that are kept stay where they are: past the first
+    // row dropped, every row moves to a strictly lower position.
+    std::ptrdiff_t kept = 0;
+    while (kept < size && pred(first[kept])) {
+        ++kept;
+    }
+    if (kept == size) {
+        return static_cast<std::size_t>(size);
+    }
+    return static_cast<std::size_t>(impl::dispatch([&] {
+        return impl::filter_rows<true>(
+            first, kept + 1, size, first, kept, size, pred,
+            std::make_index_sequence<std::tuple_size_v<pack>>{});
+    }));
+}
+
+/// gather sets each row i of the random access zipped sequence out
+/// (usually a zip_view) to the row indices[i] of in, which must have
+/// the same number of columns, for as many rows as the shortest of
+/// indices and out holds. indices is a random access sequence of
+/// integers, e.g. the result of a join, all of them less than the
+/// length of in:
+///
+///     zip::gather(zip::zip(x, y), order, zip::zip(sorted_x, sorted_y));
+///
+/// Columns are gathered one after the other, straight through the
+/// underlying iterators. The elements a few indices ahead are
+/// prefetched, so that the cache misses of the random reads overlap
+/// each other. Rows are spread over the threads of the given pool.
+template <typename Sequence, typename Indices, typename Output>
+void gather(thread_pool& pool, Sequence&& in, Indices&& indices, Output&& out) {
+    using std::begin;
+    using std::end;
+    const auto src = impl::as_offset(begin(in));
+    const auto dst = impl::as_offset(begin(out));
+    using source_pack = typename decltype(src)::pack_type;
+    using destination_pack = typename decltype(dst)::pack_type;
+    static_assert(std::tuple_size_v<source_pack> == std::tuple_size_v<destination_pack>,
+                  "source and destination must have the same number of columns");
+    const auto size =
+        std::min(static_cast<std::ptrdiff_t>(end(indices) - begin(indices)),
+                 static_cast<std::ptrdiff_t>(end(out) - begin(out)));
+    impl::gather_columns(pool, src, dst, begin(indices), size,
+                         std::make_index_sequence<std::tuple_size_v<source_pack>>{});
+}
+
+template <typename Sequence, typename Indices, typename Output>
+void gather(Sequence&& in, Indices&& indices, Output&& out) {
+    gather(default_thread_pool(), std::forward<Sequence>(in),
+           std::forward<Indices>(indices), std::forward<Output>(out));
+}
+
+/// permute_in_place reorders the rows of the random access zipped
+/// sequence seq so that row i becomes the row perm[i] was, perm
+/// being a permutation of [0, size of seq) given as a random access
+/// sequence of integers (e.g. a sort order). Columns are permuted one
+/// after the other, each of them gathered into a temporary buffer
+/// (with the same prefetching as gather) and moved back, spread over
+/// the threads of the given pool: the extra memory needed is that of
+/// the largest column, never a copy of the whole sequence.
+template <typename Sequence, typename Permutation>
+void permute_in_place(thread_pool& pool, Sequence&& seq, Permutation&& perm) {
+    using std::begin;
+    using std::end;
+    const auto first = impl::as_offset(begin(seq));
+    using pack = typename decltype(first)::pack_type;
+    const auto size =
+        std::min(static_cast<std::ptrdiff_t>(end(perm) - begin(perm)),
+                 static_cast<std::ptrdiff_t>(end(seq) - begin(seq)));
+    impl::permute_columns(pool, first, begin(perm),
+                          static_cast<std::size_t>(std::max<std::ptrdiff_t>(size, 0)),
+                          std::make_index_sequence<std::tuple_size_v<pack>>{});
+}
+
+template <typename Sequence, typename Permutation>
+void permute_in_place(Sequence&& seq, Permutation&& perm) {
+    permute_in_place(default_thread_pool(), std::forward<Sequence>(seq),
+                     std::forward<Permutation>(perm));
+}
+
+}  // namespace zip
+
+#endif
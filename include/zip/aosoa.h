@@ -0,0 +1,316 @@
+#ifndef ZIP_AOSOA_H_INCLUDED_20261017
+#define ZIP_AOSOA_H_INCLUDED_20261017
+
+#include <zip.h>
+#include <zip/soa_vector.h>
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zip {
+
+/// tile is the storage unit of an aosoa: Width consecutive rows laid
+/// out column by column, i.e. a tuple holding one W-wide lane array
+/// per column, aligned on a cache line.
+template <std::size_t Width, typename... Ts>
+struct alignas(soa_alignment) tile : std::tuple<std::array<Ts, Width>...> {
+    static constexpr std::size_t width = Width;
+};
+
+/// tile_iterator is a random access iterator over the I-th column of
+/// consecutive tiles: element n is lane n % Width of tile n / Width.
+template <typename Tile, std::size_t I>
+class tile_iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using reference = decltype(std::get<I>(std::declval<Tile&>())[0]);
+    using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+    using pointer = std::add_pointer_t<reference>;
+
+    constexpr tile_iterator() noexcept = default;
+
+    constexpr tile_iterator(Tile* tiles, difference_type index) noexcept
+        : m_tiles{tiles}, m_index{index} {}
+
+    constexpr reference operator*() const noexcept { return (*this)[0]; }
+
+    // Rows are never negative, and Width is usually a power of two:
+    // unsigned division boils down to a shift and a mask.
+    constexpr reference operator[](difference_type n) const noexcept {
+        const auto row = static_cast<std::size_t>(m_index + n);
+        return std::get<I>(m_tiles[row / Tile::width])[row % Tile::width];
+    }
+
+    constexpr tile_iterator& operator++() noexcept { return *this += 1; }
+
+    constexpr tile_iterator operator++(int) noexcept {
+        auto ret = *this;
+        ++*this;
+        return ret;
+    }
+
+    constexpr tile_iterator& operator--() noexcept { return *this -= 1; }
+
+    constexpr tile_iterator operator--(int) noexcept {
+        auto ret = *this;
+        --*this;
+        return ret;
+    }
+
+    constexpr tile_iterator& operator+=(difference_type n) noexcept {
+        m_index += n;
+        return *this;
+    }
+
+    constexpr tile_iterator& operator-=(difference_type n) noexcept {
+        m_index -= n;
+        return *this;
+    }
+
+    friend constexpr tile_iterator operator+(tile_iterator it,
+                                             difference_type n) noexcept {
+        return it += n;
+    }
+
+    friend constexpr tile_iterator operator+(difference_type n,
+                                             tile_iterator it) noexcept {
+        return it += n;
+    }
+
+    friend constexpr tile_iterator operator-(tile_iterator it,
+                                             difference_type n) noexcept {
+        return it -= n;
+    }
+
+    friend constexpr difference_type operator-(const tile_iterator& lhs,
+                                               const tile_iterator& rhs) noexcept {
+        return lhs.m_index - rhs.m_index;
+    }
+
+    // Iterators over the same tiles only differ by their row.
+    friend constexpr bool operator==(const tile_iterator& lhs,
+                                     const tile_iterator& rhs) noexcept {
+        return lhs.m_index == rhs.m_index;
+    }
+
+    friend constexpr bool operator!=(const tile_iterator& lhs,
+                                     const tile_iterator& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const tile_iterator& lhs,
+                                    const tile_iterator& rhs) noexcept {
+        return lhs.m_index < rhs.m_index;
+    }
+
+    friend constexpr bool operator>(const tile_iterator& lhs,
+                                    const tile_iterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const tile_iterator& lhs,
+                                     const tile_iterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const tile_iterator& lhs,
+                                     const tile_iterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+   private:
+    Tile* m_tiles = nullptr;
+    difference_type m_index = 0;
+};
+
+/// aosoa is an owning array-of-structs-of-arrays container: rows are
+/// stored Width at a time in tiles, each tile holding one Width-wide
+/// lane array per column. Kernels touching all the columns of a row
+/// then walk a single stream of memory, as with an array of structs,
+/// while each column of a tile is still a contiguous, vectorisable
+/// array, as with a structure of arrays.
+///
+/// Iterating over the container yields the same tuples of references
+/// as zip(), through offset_iterators over tile_iterators. tiles()
+/// is the tile-level traversal, handing whole lane arrays to kernels:
+///
+///     for (auto&& [x, y] : v.tiles()) {
+///         for (std::size_t i = 0; i < 8; ++i) { x[i] += y[i]; }
+///     }
+///
+/// The lanes of the last tile past size() are value-initialised, so
+/// that such kernels can always process full tiles. Tiles are padded
+/// to a multiple of soa_alignment: Width is best picked so that lane
+/// arrays fill whole cache lines, e.g. 16 for 32-bit columns.
+/// Columns must be trivially copyable.
+template <std::size_t Width, typename... Ts>
+class aosoa {
+    static_assert(Width > 0, "aosoa tile width must be positive");
+    static_assert(sizeof...(Ts) > 0, "aosoa needs at least one column");
+    static_assert(((std::is_trivially_copyable_v<Ts> &&
+                    std::is_default_constructible_v<Ts> && !std::is_const_v<Ts>) &&
+                   ...),
+                  "aosoa columns must be trivially copyable non-const types");
+
+    using indexes = std::index_sequence_for<Ts...>;
+
+    template <typename Tile, typename Indexes>
+    struct iterator_for;
+
+    template <typename Tile, std::size_t... Is>
+    struct iterator_for<Tile, std::index_sequence<Is...>> {
+        using type = offset_iterator<tile_iterator<Tile, Is>...>;
+    };
+
+   public:
+    static constexpr std::size_t width = Width;
+    using tile_type = tile<Width, Ts...>;
+    using value_type = std::tuple<Ts...>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = typename iterator_for<tile_type, indexes>::type;
+    using const_iterator = typename iterator_for<const tile_type, indexes>::type;
+    using reference = typename iterator::reference;
+    using const_reference = typename const_iterator::reference;
+
+    aosoa() = default;
+
+    explicit aosoa(size_type count) { resize(count); }
+
+    aosoa(std::initializer_list<value_type> init) {
+        reserve(std::size(init));
+        for (auto&& value : init) {
+            push_back(value);
+        }
+    }
+
+    size_type size() const noexcept { return m_size; }
+
+    size_type capacity() const noexcept { return m_tiles.capacity() * Width; }
+
+    bool empty() const noexcept { return m_size == 0; }
+
+    iterator begin() noexcept { return make_begin<iterator>(m_tiles.data(), indexes{}); }
+
+    iterator end() noexcept { return begin() + static_cast<difference_type>(m_size); }
+
+    const_iterator begin() const noexcept { return cbegin(); }
+
+    const_iterator end() const noexcept { return cend(); }
+
+    const_iterator cbegin() const noexcept {
+        return make_begin<const_iterator>(m_tiles.data(), indexes{});
+    }
+
+    const_iterator cend() const noexcept {
+        return cbegin() + static_cast<difference_type>(m_size);
+    }
+
+    /// The tiles holding the rows, the last one possibly partially
+    /// filled.
+    slice<tile_type*> tiles() noexcept {
+        return {m_tiles.data(), m_tiles.data() + m_tiles.size()};
+    }
+
+    slice<const tile_type*> tiles() const noexcept {
+        return {m_tiles.data(), m_tiles.data() + m_tiles.size()};
+    }
+
+    reference operator[](size_type pos) noexcept {
+        return begin()[static_cast<difference_type>(pos)];
+    }
+
+    const_reference operator[](size_type pos) const noexcept {
+        return cbegin()[static_cast<difference_type>(pos)];
+    }
+
+    reference back() noexcept { return (*this)[m_size - 1]; }
+
+    const_reference back() const noexcept { return (*this)[m_size - 1]; }
+
+    void reserve(size_type new_capacity) { m_tiles.reserve(tile_count(new_capacity)); }
+
+    void resize(size_type count) {
+        m_tiles.resize(tile_count(count));
+        if (count < m_size) {
+            reset_tail(count);
+        }
+        m_size = count;
+    }
+
+    void clear() noexcept {
+        m_tiles.clear();
+        m_size = 0;
+    }
+
+    void push_back(const value_type& value) { emplace_back() = value; }
+
+    /// Appends a row whose columns are set from the corresponding
+    /// args, or value-initialised when no args are given at all.
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == 0 || sizeof...(Args) == sizeof...(Ts),
+                      "emplace_back needs exactly one argument per column");
+        value_type value(std::forward<Args>(args)...);
+        if (m_size % Width == 0) {
+            m_tiles.emplace_back();
+        }
+        auto ret = (*this)[m_size++];
+        ret = std::move(value);
+        return ret;
+    }
+
+    void pop_back() noexcept { resize(m_size - 1); }
+
+    void swap(aosoa& other) noexcept {
+        m_tiles.swap(other.m_tiles);
+        std::swap(m_size, other.m_size);
+    }
+
+    friend void swap(aosoa& lhs, aosoa& rhs) noexcept { lhs.swap(rhs); }
+
+   private:
+    static constexpr size_type tile_count(size_type rows) noexcept {
+        return (rows + Width - 1) / Width;
+    }
+
+    template <typename Iterator, typename Tile, std::size_t... Is>
+    static Iterator make_begin(Tile* tiles, std::index_sequence<Is...>) noexcept {
+        return Iterator{tile_iterator<Tile, Is>{tiles, 0}...};
+    }
+
+    // Value-initialises the lanes past the first count rows, which
+    // may have been left over by a shrinking resize.
+    void reset_tail(size_type count) noexcept {
+        for (auto row = count; row < m_tiles.size() * Width; ++row) {
+            (*this)[row] = value_type{};
+        }
+    }
+
+    std::vector<tile_type> m_tiles;
+    size_type m_size = 0;
+};
+
+}  // namespace zip
+
+namespace std {
+
+template <std::size_t Width, typename... Ts>
+struct tuple_size<zip::tile<Width, Ts...>>
+    : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t I, std::size_t Width, typename... Ts>
+struct tuple_element<I, zip::tile<Width, Ts...>> {
+    using type = std::array<zip::nth_type_t<I, Ts...>, Width>;
+};
+
+}  // namespace std
+
+#endif
@@ -0,0 +1,268 @@
+#ifndef ZIP_EXPR_H_INCLUDED_20261017
+#define ZIP_EXPR_H_INCLUDED_20261017
+
+#include <zip.h>
+#include <zip/isa.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace zip {
+
+namespace impl {
+
+// Stages of an expression are composed at compile time into a single
+// function object, applied to each row of the zipped columns.
+
+// The stages of expr(seqs...) before any is added: rows as they are.
+struct row_stage {
+    template <typename Row>
+    constexpr Row operator()(Row&& row) const {
+        return std::forward<Row>(row);
+    }
+};
+
+// The first stage added to an expression gets one argument per column.
+template <typename Function>
+struct unpack_stage {
+    template <typename Row>
+    constexpr decltype(auto) operator()(Row&& row) const {
+        return std::apply(f, std::forward<Row>(row));
+    }
+
+    Function f;
+};
+
+// Each later stage gets whatever the previous ones returned.
+template <typename First, typename Second>
+struct chain_stage {
+    template <typename Row>
+    constexpr decltype(auto) operator()(Row&& row) const {
+        return second(first(std::forward<Row>(row)));
+    }
+
+    First first;
+    Second second;
+};
+
+}  // namespace impl
+
+/// expression_iterator is the random access iterator over an
+/// expression: dereferencing it applies all the stages of the
+/// expression to the row under the underlying iterator, on the fly.
+template <typename Iterator, typename Function>
+class expression_iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    using reference =
+        decltype(std::declval<const Function&>()(*std::declval<Iterator>()));
+    using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+    using pointer = void;
+
+    constexpr expression_iterator() = default;
+
+    constexpr expression_iterator(Iterator it, const Function* f) noexcept
+        : m_it{std::move(it)}, m_f{f} {}
+
+    constexpr reference operator*() const { return (*m_f)(*m_it); }
+
+    constexpr reference operator[](difference_type n) const { return (*m_f)(m_it[n]); }
+
+    constexpr expression_iterator& operator++() {
+        ++m_it;
+        return *this;
+    }
+
+    constexpr expression_iterator operator++(int) {
+        auto ret = *this;
+        ++*this;
+        return ret;
+    }
+
+    constexpr expression_iterator& operator--() {
+        --m_it;
+        return *this;
+    }
+
+    constexpr expression_iterator operator--(int) {
+        auto ret = *this;
+        --*this;
+        return ret;
+    }
+
+    constexpr expression_iterator& operator+=(difference_type n) {
+        m_it += n;
+        return *this;
+    }
+
+    constexpr expression_iterator& operator-=(difference_type n) {
+        m_it -= n;
+        return *this;
+    }
+
+    friend constexpr expression_iterator operator+(expression_iterator it,
+                                                   difference_type n) {
+        return it += n;
+    }
+
+    friend constexpr expression_iterator operator+(difference_type n,
+                                                   expression_iterator it) {
+        return it += n;
+    }
+
+    friend constexpr expression_iterator operator-(expression_iterator it,
+                                                   difference_type n) {
+        return it -= n;
+    }
+
+    friend constexpr difference_type operator-(const expression_iterator& lhs,
+                                               const expression_iterator& rhs) {
+        return lhs.m_it - rhs.m_it;
+    }
+
+    friend constexpr bool operator==(const expression_iterator& lhs,
+                                     const expression_iterator& rhs) {
+        return lhs.m_it == rhs.m_it;
+    }
+
+    friend constexpr bool operator!=(const expression_iterator& lhs,
+                                     const expression_iterator& rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const expression_iterator& lhs,
+                                    const expression_iterator& rhs) {
+        return lhs.m_it < rhs.m_it;
+    }
+
+    friend constexpr bool operator>(const expression_iterator& lhs,
+                                    const expression_iterator& rhs) {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const expression_iterator& lhs,
+                                     const expression_iterator& rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const expression_iterator& lhs,
+                                     const expression_iterator& rhs) {
+        return !(lhs < rhs);
+    }
+
+   private:
+    Iterator m_it{};
+    const Function* m_f = nullptr;
+};
+
+/// expression is a lazy, element-wise computation over zipped
+/// columns, returned by expr(). Calling it with a function adds a
+/// stage, which returns a new expression: nothing is evaluated until
+/// the expression is walked, by assign() or any algorithm taking a
+/// random access sequence (e.g. zip::reduce), and then all the
+/// stages run one after the other on each row in a single pass.
+/// Expressions refer to their columns, which must outlive them, and
+/// their iterators refer to the expression itself.
+template <typename Iterator, typename Function>
+class expression {
+   public:
+    using iterator = expression_iterator<Iterator, Function>;
+    using const_iterator = iterator;
+    using value_type = typename iterator::value_type;
+    using difference_type = typename iterator::difference_type;
+    using size_type = std::make_unsigned_t<difference_type>;
+
+    constexpr expression(Iterator first, difference_type size, Function f)
+        : m_first{std::move(first)}, m_size{size}, m_f{std::move(f)} {}
+
+    constexpr iterator begin() const noexcept { return {m_first, &m_f}; }
+
+    constexpr iterator end() const noexcept { return begin() + m_size; }
+
+    constexpr size_type size() const noexcept { return static_cast<size_type>(m_size); }
+
+    constexpr decltype(auto) operator[](difference_type idx) const {
+        return begin()[idx];
+    }
+
+    /// Returns the expression applying f to the values of this one.
+    template <typename F>
+    constexpr auto operator()(F f) const {
+        if constexpr (std::is_same_v<Function, impl::row_stage>) {
+            return make(impl::unpack_stage<F>{std::move(f)});
+        } else {
+            return make(impl::chain_stage<Function, F>{m_f, std::move(f)});
+        }
+    }
+
+   private:
+    template <typename F>
+    constexpr expression<Iterator, F> make(F f) const {
+        return {m_first, m_size, std::move(f)};
+    }
+
+    Iterator m_first;
+    difference_type m_size;
+    Function m_f;
+};
+
+/// expr starts an expression over the given columns, zipped as by
+/// zip() and walked through an offset_iterator. The first stage
+/// added gets one argument per column, the later ones the value
+/// returned by the previous stage:
+///
+///     zip::assign(out, zip::expr(x, y, z)([](auto x, auto y, auto z) {
+///         return x * y + z;
+///     })([](auto v) { return v < 0 ? -v : v; }));
+///
+/// Stages are inlined into one loop, with no temporary column in
+/// between: each column is read once and the output written once.
+template <typename... Sequences>
+constexpr auto expr(Sequences&&... seqs) {
+    auto view = zip(std::forward<Sequences>(seqs)...);
+    static_assert(is_compatible_iterator_category_v<
+                      typename decltype(view)::iterator_category,
+                      std::random_access_iterator_tag>,
+                  "expr needs random access sequences");
+    auto first = impl::as_offset(view.begin());
+    using difference_type = typename decltype(first)::difference_type;
+    return expression<decltype(first), impl::row_stage>{
+        first, static_cast<difference_type>(view.size()), impl::row_stage{}};
+}
+
+/// assign evaluates the random access sequence src (usually an
+/// expression) into out, a single column or zipped columns, row by
+/// row in one loop driven by a single offset, up to the end of the
+/// shortest of both. Zipped columns are assigned from tuples. Columns
+/// zipped with zip(no_alias, ...) are written through __restrict
+/// pointers: src must not read any of them.
+template <typename Sequence, typename Source>
+void assign(Sequence&& out, const Source& src) {
+    using std::begin;
+    using std::end;
+    using difference_type = std::ptrdiff_t;
+    const auto size = std::min<difference_type>(end(out) - begin(out),
+                                                end(src) - begin(src));
+    auto dst = impl::as_offset(begin(out));
+    auto first = impl::as_offset(begin(src));
+    impl::dispatch([&] {
+        if constexpr (is_no_alias_iterator_v<decltype(dst)>) {
+            impl::no_alias_rows(dst, size, [&first](const auto& rows, difference_type i) {
+                rows[i] = first[i];
+            });
+        } else {
+            for (difference_type i = 0; i < size; ++i) {
+                dst[i] = first[i];
+            }
+        }
+    });
+}
+
+}  // namespace zip
+
+#endif
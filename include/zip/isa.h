@@ -0,0 +1,179 @@
+#ifndef ZIP_ISA_H_INCLUDED_20261017
+#define ZIP_ISA_H_INCLUDED_20261017
+
+#include <zip.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <string_view>
+
+// Clones are only built where compilers can target an instruction set
+// per function, and tell at runtime which ones the CPU has.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define ZIP_ISA_DISPATCH 1
+#else
+#define ZIP_ISA_DISPATCH 0
+#endif
+
+namespace zip {
+
+/// isa lists the instruction sets the algorithms of zip are built for,
+/// on top of the one targeted by the build, each one a superset of the
+/// previous one. They follow the x86-64 micro-architecture levels:
+/// sse4_2 is x86-64-v2, avx2 is x86-64-v3 and avx512 is x86-64-v4, all
+/// without FMA, so that no clone rounds differently from the others.
+enum class isa { generic, sse4_2, avx2, avx512 };
+
+/// Returns the name of target, as given to the ZIP_ISA environment
+/// variable.
+constexpr const char* isa_name(isa target) noexcept {
+    switch (target) {
+        case isa::sse4_2:
+            return "sse4.2";
+        case isa::avx2:
+            return "avx2";
+        case isa::avx512:
+            return "avx512";
+        case isa::generic:
+            break;
+    }
+    return "generic";
+}
+
+namespace impl {
+
+inline isa detect_isa() noexcept {
+#if ZIP_ISA_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx2") &&
+        __builtin_cpu_supports("bmi2")) {
+        return isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") &&
+        __builtin_cpu_supports("bmi2")) {
+        return isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) {
+        return isa::sse4_2;
+    }
+#endif
+    return isa::generic;
+}
+
+// parse_isa returns the instruction set named name, if any, as long
+// as the CPU supports it, or else the widest one it does support.
+// Unknown names are ignored.
+inline isa parse_isa(const char* name, isa supported) noexcept {
+    if (name != nullptr) {
+        for (auto target : {isa::generic, isa::sse4_2, isa::avx2, isa::avx512}) {
+            if (std::string_view{name} == isa_name(target)) {
+                return std::min(target, supported);
+            }
+        }
+    }
+    return supported;
+}
+
+}  // namespace impl
+
+/// supported_isa returns the widest instruction set the CPU runs,
+/// looked up once, with cpuid.
+inline isa supported_isa() noexcept {
+    static const isa supported = impl::detect_isa();
+    return supported;
+}
+
+namespace impl {
+
+inline std::atomic<isa>& active_isa_slot() noexcept {
+    static std::atomic<isa> active{parse_isa(std::getenv("ZIP_ISA"), supported_isa())};
+    return active;
+}
+
+}  // namespace impl
+
+/// active_isa returns the instruction set the algorithms of zip run
+/// with: the one supported by the CPU, unless the ZIP_ISA environment
+/// variable names a narrower one (generic, sse4.2, avx2 or avx512).
+/// Both are looked up once, the first time an algorithm runs.
+inline isa active_isa() noexcept {
+    return impl::active_isa_slot().load(std::memory_order_relaxed);
+}
+
+/// set_active_isa makes the algorithms of zip run with target, or the
+/// widest instruction set the CPU supports if it is narrower, and
+/// returns the previous one. This is meant for tests and benchmarks
+/// comparing the clones, not to be called while algorithms run.
+inline isa set_active_isa(isa target) noexcept {
+    return impl::active_isa_slot().exchange(std::min(target, supported_isa()),
+                                            std::memory_order_relaxed);
+}
+
+namespace impl {
+
+#if ZIP_ISA_DISPATCH
+// Each clone inlines f, with everything it calls, into a function
+// built for its instruction set: the loops of the kernel are compiled
+// again, vectorised for the wider registers.
+template <typename Function>
+__attribute__((target("sse4.2,popcnt"), flatten)) decltype(auto) run_sse4_2(
+    Function& f) {
+    return f();
+}
+
+template <typename Function>
+__attribute__((target("avx2,bmi,bmi2,lzcnt,popcnt,movbe"), flatten)) decltype(auto)
+run_avx2(Function& f) {
+    return f();
+}
+
+// GCC vectorises for 512-bit registers as soon as it may, which is
+// slower than 256-bit ones for the reductions: AVX-512 is mostly
+// there for the masked loads and stores. clang does not take that
+// option in the attribute.
+#if defined(__clang__)
+#define ZIP_ISA_AVX512_TARGET \
+    "avx512f,avx512bw,avx512cd,avx512dq,avx512vl,avx2,bmi,bmi2,lzcnt,popcnt,movbe"
+#else
+#define ZIP_ISA_AVX512_TARGET                                                       \
+    "avx512f,avx512bw,avx512cd,avx512dq,avx512vl,avx2,bmi,bmi2,lzcnt,popcnt,movbe," \
+    "prefer-vector-width=256"
+#endif
+
+template <typename Function>
+__attribute__((target(ZIP_ISA_AVX512_TARGET), flatten)) decltype(auto) run_avx512(
+    Function& f) {
+    return f();
+}
+#endif
+
+// dispatch calls f(), through its clone for active_isa(). Algorithms
+// (transform_reduce and reduce, assign, for_each, filter_copy and
+// compact, gather and permute_in_place) wrap the serial kernels they
+// run on each thread with it, once per block of rows.
+template <typename Function>
+decltype(auto) dispatch(Function&& f) {
+#if ZIP_ISA_DISPATCH
+    switch (active_isa()) {
+        case isa::avx512:
+            return run_avx512(f);
+        case isa::avx2:
+            return run_avx2(f);
+        case isa::sse4_2:
+            return run_sse4_2(f);
+        case isa::generic:
+            break;
+    }
+#endif
+    return f();
+}
+
+}  // namespace impl
+
+}  // namespace zip
+
+#endif
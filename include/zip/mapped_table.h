@@ -0,0 +1,371 @@
+#ifndef ZIP_MAPPED_TABLE_H_INCLUDED_20261017
+#define ZIP_MAPPED_TABLE_H_INCLUDED_20261017
+
+#include <zip.h>
+#include <zip/soa_vector.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace zip {
+
+//
+// On-disk layout
+//
+// A table file starts with a table_header, followed by one
+// table_column descriptor per column, in order. Each column is then
+// stored as a plain array of its elements, starting at the offset
+// given by its descriptor, which is a multiple of soa_alignment. All
+// the fields are in the byte order of the machine writing the file,
+// which byte_order tells readers about.
+//
+
+struct table_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t columns;
+    std::uint64_t rows;
+};
+
+struct table_column {
+    /// Kind of element (see column_type_code) and its size in bytes.
+    std::uint32_t type;
+    std::uint32_t size;
+    std::uint64_t offset;
+};
+
+inline constexpr char table_magic[8] = {'Z', 'I', 'P', 'T', 'A', 'B', 'L', 'E'};
+inline constexpr std::uint32_t table_version = 1;
+inline constexpr std::uint32_t table_byte_order = 0x01020304;
+
+/// column_type_code tells apart the columns types that share a size:
+/// signed and unsigned integers, floating point numbers, and opaque
+/// trivially copyable types, which are only checked by size.
+template <typename T>
+constexpr std::uint32_t column_type_code() noexcept {
+    if constexpr (std::is_same_v<T, bool>) {
+        return 4;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return 3;
+    } else if constexpr (std::is_integral_v<T>) {
+        return std::is_signed_v<T> ? 1 : 2;
+    } else {
+        return 0;
+    }
+}
+
+namespace impl {
+
+constexpr std::uint64_t table_round_up(std::uint64_t bytes) noexcept {
+    return (bytes + soa_alignment - 1) / soa_alignment * soa_alignment;
+}
+
+// table_layout returns the descriptors of a table of rows elements of
+// types Ts..., with columns laid out one after the other past the
+// header, each one padded to soa_alignment.
+template <typename... Ts>
+std::array<table_column, sizeof...(Ts)> table_layout(std::uint64_t rows) noexcept {
+    auto offset = table_round_up(sizeof(table_header) +
+                                 sizeof...(Ts) * sizeof(table_column));
+    std::array<table_column, sizeof...(Ts)> ret{
+        {{column_type_code<Ts>(), static_cast<std::uint32_t>(sizeof(Ts)), 0}...}};
+    for (auto& column : ret) {
+        column.offset = offset;
+        offset += table_round_up(rows * column.size);
+    }
+    return ret;
+}
+
+[[noreturn]] inline void throw_table_error(const std::string& path, const char* what) {
+    throw std::runtime_error("zip::mapped_table: " + path + ": " + what);
+}
+
+[[noreturn]] inline void throw_system_error(const std::string& path, const char* what) {
+    throw std::system_error(errno, std::generic_category(),
+                            "zip::mapped_table: " + path + ": " + what);
+}
+
+// write_column writes rows elements of the column starting at it,
+// straight from memory when it is a pointer, and through a bounded
+// buffer otherwise.
+template <typename T, typename Iterator>
+void write_column(std::ofstream& out, Iterator it, std::uint64_t rows) {
+    if constexpr (std::is_pointer_v<Iterator>) {
+        out.write(reinterpret_cast<const char*>(it),
+                  static_cast<std::streamsize>(rows * sizeof(T)));
+    } else {
+        constexpr std::uint64_t buffer_rows = (std::uint64_t{1} << 16) / sizeof(T) + 1;
+        std::vector<T> buffer(static_cast<std::size_t>(std::min(rows, buffer_rows)));
+        for (std::uint64_t row = 0; row < rows;) {
+            const auto n = static_cast<std::size_t>(std::min(rows - row, buffer_rows));
+            for (std::size_t i = 0; i < n; ++i, ++it) {
+                buffer[i] = *it;
+            }
+            out.write(reinterpret_cast<const char*>(buffer.data()),
+                      static_cast<std::streamsize>(n * sizeof(T)));
+            row += n;
+        }
+    }
+}
+
+template <typename Iterator, std::size_t... Is>
+void write_table(const std::string& path, const Iterator& first, std::uint64_t rows,
+                 std::index_sequence<Is...>) {
+    using columns = std::tuple<std::remove_cv_t<
+        std::remove_reference_t<decltype(std::get<Is>(*std::declval<Iterator>()))>>...>;
+    static_assert(
+        (std::is_trivially_copyable_v<std::tuple_element_t<Is, columns>> && ...),
+        "mapped_table columns must be trivially copyable");
+
+    const auto layout = table_layout<std::tuple_element_t<Is, columns>...>(rows);
+    table_header header{};
+    std::copy(std::begin(table_magic), std::end(table_magic), header.magic);
+    header.version = table_version;
+    header.byte_order = table_byte_order;
+    header.columns = sizeof...(Is);
+    header.rows = rows;
+
+    std::ofstream out;
+    out.exceptions(std::ios::failbit | std::ios::badbit);
+    out.open(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(layout.data()),
+              static_cast<std::streamsize>(sizeof(layout)));
+
+    // Padding is written explicitly rather than seeked over, so that
+    // the file holds no hole and its size covers the last column.
+    static constexpr char padding[soa_alignment] = {};
+    const auto pad_to = [&out](std::uint64_t offset) {
+        const auto pos = static_cast<std::uint64_t>(out.tellp());
+        out.write(padding, static_cast<std::streamsize>(offset - pos));
+    };
+    ((pad_to(layout[Is].offset),
+      write_column<std::tuple_element_t<Is, columns>>(
+          out, std::get<Is>(first.iterators()) + first.m_offset, rows)),
+     ...);
+    pad_to(table_round_up(static_cast<std::uint64_t>(out.tellp())));
+    out.close();
+}
+
+}  // namespace impl
+
+/// write_table stores the random access zipped sequence seq (usually a
+/// zip_view) to the file at path, in the format read by mapped_table.
+/// Each column must be trivially copyable, and is written as a whole
+/// (straight from memory when it is contiguous), one after the other.
+/// Throws std::ios_base::failure when the file cannot be written.
+template <typename Sequence>
+void write_table(const std::string& path, Sequence&& seq) {
+    using std::begin;
+    using std::end;
+    using iterator_category =
+        typename std::iterator_traits<decltype(begin(seq))>::iterator_category;
+    static_assert(
+        std::is_convertible_v<iterator_category, std::random_access_iterator_tag>,
+        "write_table needs a random access sequence");
+    static_assert(impl::has_iterator_pack<decltype(begin(seq))>::value,
+                  "write_table needs a zipped sequence");
+    const auto size = end(seq) - begin(seq);
+    const auto first = impl::as_offset(begin(seq));
+    impl::write_table(
+        path, first, static_cast<std::uint64_t>(std::max<decltype(size)>(size, 0)),
+        std::make_index_sequence<
+            std::tuple_size_v<typename decltype(first)::pack_type>>{});
+}
+
+/// mapped_table maps a file written by write_table in memory, and
+/// exposes its columns of types Ts... without reading nor copying them:
+/// opening a table costs the same whatever its size, and pages are
+/// only read from disk as they are first accessed.
+///
+///     zip::mapped_table<int, float> table{"columns.zip"};
+///     for (auto&& [id, weight] : table.view()) { ... }
+///
+/// The mapping is read-only. Column types are checked against the
+/// header of the file, by kind (integer, floating point...) and size,
+/// and std::runtime_error is thrown on any mismatch; system errors are
+/// reported through std::system_error. Views refer to the table, which
+/// must outlive them.
+template <typename... Ts>
+class mapped_table {
+    static_assert(sizeof...(Ts) > 0, "mapped_table needs at least one column");
+    static_assert(((std::is_trivially_copyable_v<Ts> && !std::is_const_v<Ts> &&
+                    alignof(Ts) <= soa_alignment) &&
+                   ...),
+                  "mapped_table columns must be trivially copyable non-const types");
+
+    using indexes = std::index_sequence_for<Ts...>;
+
+   public:
+    using size_type = std::size_t;
+
+    explicit mapped_table(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            impl::throw_system_error(path, "cannot open");
+        }
+        try {
+            map(path, fd);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        // The mapping outlives the descriptor.
+        ::close(fd);
+        m_columns = make_columns(indexes{});
+    }
+
+    mapped_table(const mapped_table&) = delete;
+
+    mapped_table& operator=(const mapped_table&) = delete;
+
+    mapped_table(mapped_table&& other) noexcept { swap(other); }
+
+    mapped_table& operator=(mapped_table&& other) noexcept {
+        mapped_table{std::move(other)}.swap(*this);
+        return *this;
+    }
+
+    ~mapped_table() {
+        if (m_data) {
+            ::munmap(m_data, m_bytes);
+        }
+    }
+
+    size_type size() const noexcept { return m_rows; }
+
+    bool empty() const noexcept { return m_rows == 0; }
+
+    /// The I-th column, a contiguous sequence of its elements.
+    template <std::size_t I>
+    const auto& column() const noexcept {
+        return std::get<I>(m_columns);
+    }
+
+    /// A zip_view over all the columns, walked by offset_iterators.
+    auto view() const noexcept {
+        return std::apply([](const auto&... columns) { return zip(columns...); },
+                          m_columns);
+    }
+
+    void swap(mapped_table& other) noexcept {
+        std::swap(m_data, other.m_data);
+        std::swap(m_bytes, other.m_bytes);
+        std::swap(m_rows, other.m_rows);
+        std::swap(m_layout, other.m_layout);
+        std::swap(m_columns, other.m_columns);
+    }
+
+    friend void swap(mapped_table& lhs, mapped_table& rhs) noexcept { lhs.swap(rhs); }
+
+   private:
+    void map(const std::string& path, int fd) {
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            impl::throw_system_error(path, "cannot stat");
+        }
+        const auto bytes = static_cast<std::uint64_t>(st.st_size);
+        if (bytes < sizeof(table_header)) {
+            impl::throw_table_error(path, "truncated header");
+        }
+        void* data = ::mmap(nullptr, static_cast<std::size_t>(bytes), PROT_READ,
+                            MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            impl::throw_system_error(path, "cannot map");
+        }
+        m_data = data;
+        m_bytes = static_cast<std::size_t>(bytes);
+        // The header is checked in place: the constructor is failing
+        // if it does not pass, so the mapping must be undone here.
+        try {
+            check(path);
+        } catch (...) {
+            ::munmap(m_data, m_bytes);
+            m_data = nullptr;
+            throw;
+        }
+    }
+
+    const std::byte* bytes() const noexcept {
+        return static_cast<const std::byte*>(m_data);
+    }
+
+    void check(const std::string& path) {
+        table_header header;
+        std::memcpy(&header, bytes(), sizeof(header));
+        if (!std::equal(std::begin(table_magic), std::end(table_magic), header.magic)) {
+            impl::throw_table_error(path, "not a table file");
+        }
+        if (header.byte_order != table_byte_order) {
+            impl::throw_table_error(path, "foreign byte order");
+        }
+        if (header.version != table_version) {
+            impl::throw_table_error(path, "unsupported version");
+        }
+        if (header.columns != sizeof...(Ts)) {
+            impl::throw_table_error(path, "column count mismatch");
+        }
+        if (m_bytes < sizeof(table_header) + sizeof(m_layout)) {
+            impl::throw_table_error(path, "truncated header");
+        }
+        std::memcpy(m_layout.data(), bytes() + sizeof(table_header), sizeof(m_layout));
+        m_rows = static_cast<size_type>(header.rows);
+        constexpr std::array<table_column, sizeof...(Ts)> expected{
+            {{column_type_code<Ts>(), static_cast<std::uint32_t>(sizeof(Ts)), 0}...}};
+        for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+            const auto& column = m_layout[i];
+            if (column.type != expected[i].type || column.size != expected[i].size) {
+                impl::throw_table_error(path, "column type mismatch");
+            }
+            if (column.offset % soa_alignment != 0) {
+                impl::throw_table_error(path, "misaligned column");
+            }
+            // Also guards the multiplication against overflow.
+            if (column.offset > m_bytes ||
+                header.rows > (m_bytes - column.offset) / column.size) {
+                impl::throw_table_error(path, "truncated column");
+            }
+        }
+    }
+
+    template <std::size_t... Is>
+    std::tuple<slice<const Ts*>...> make_columns(
+        std::index_sequence<Is...>) const noexcept {
+        return {make_column<Ts>(m_layout[Is].offset)...};
+    }
+
+    template <typename T>
+    slice<const T*> make_column(std::uint64_t offset) const noexcept {
+        const auto* first = reinterpret_cast<const T*>(bytes() + offset);
+        return {first, first + m_rows};
+    }
+
+    void* m_data = nullptr;
+    size_type m_bytes = 0;
+    size_type m_rows = 0;
+    std::array<table_column, sizeof...(Ts)> m_layout{};
+    std::tuple<slice<const Ts*>...> m_columns{};
+};
+
+}  // namespace zip
+
+#endif
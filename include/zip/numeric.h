@@ -0,0 +1,149 @@
+#ifndef ZIP_NUMERIC_H_INCLUDED_20261017
+#define ZIP_NUMERIC_H_INCLUDED_20261017
+
+#include <zip.h>
+#include <zip/isa.h>
+#include <zip/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zip {
+
+namespace impl {
+
+// Reductions split the sequence into blocks of a fixed size, and each
+// block into a fixed number of lanes: neither depends on the pool nor
+// on the target, which is what makes results reproducible.
+inline constexpr std::size_t reduce_lanes = 8;
+inline constexpr std::size_t reduce_block_size = 512 * reduce_lanes;
+
+// tree_reduce combines values[0, size) pairwise, in a shape that only
+// depends on size: ((v0 + v1) + (v2 + v3)) + ((v4 + v5) + ...
+template <typename T, typename BinaryOp>
+T tree_reduce(T* values, std::size_t size, BinaryOp& op) {
+    for (std::size_t stride = 1; stride < size; stride *= 2) {
+        for (std::size_t i = 0; i + stride < size; i += 2 * stride) {
+            values[i] = op(std::move(values[i]), std::move(values[i + stride]));
+        }
+    }
+    return std::move(values[0]);
+}
+
+// block_reduce reduces [lo, hi) into reduce_lanes accumulators, lane j
+// getting elements j, j + reduce_lanes, j + 2 * reduce_lanes... and
+// then combines the lanes with tree_reduce. Lanes are independent of
+// each other, so that each step can be vectorised without reordering
+// any floating point operation.
+template <typename T, typename Iterator, typename BinaryOp, typename UnaryOp,
+          std::size_t... Lanes>
+T block_reduce(const Iterator& first, std::size_t lo, std::size_t hi, BinaryOp& op,
+               UnaryOp& f, std::index_sequence<Lanes...>) {
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    const auto at = [&first](std::size_t i) {
+        return first[static_cast<difference_type>(i)];
+    };
+
+    if (hi - lo < reduce_lanes) {
+        T acc = f(at(lo));
+        for (auto i = lo + 1; i < hi; ++i) {
+            acc = op(std::move(acc), f(at(i)));
+        }
+        return acc;
+    }
+
+    std::array<T, reduce_lanes> acc{T(f(at(lo + Lanes)))...};
+    auto i = lo + reduce_lanes;
+    for (; i + reduce_lanes <= hi; i += reduce_lanes) {
+        for (std::size_t j = 0; j < reduce_lanes; ++j) {
+            acc[j] = op(std::move(acc[j]), f(at(i + j)));
+        }
+    }
+    for (std::size_t j = 0; i + j < hi; ++j) {
+        acc[j] = op(std::move(acc[j]), f(at(i + j)));
+    }
+    return tree_reduce(acc.data(), reduce_lanes, op);
+}
+
+}  // namespace impl
+
+/// transform_reduce applies f to every element of the random access
+/// sequence seq (usually a zip_view) and reduces the results along
+/// with init using op, which must be associative and commutative.
+///
+/// Unlike std::transform_reduce, the order in which op is applied is
+/// fixed: the sequence is cut into blocks of impl::reduce_block_size
+/// elements, each block is reduced using impl::reduce_lanes parallel
+/// accumulators which are then combined pairwise, and so are the
+/// block results. Since none of this depends on the number of threads
+/// nor on the SIMD width of the target, floating point results are
+/// bitwise identical from one run (or machine) to another. On top of
+/// that, the independent accumulators let compilers vectorise the
+/// reduction without -ffast-math. Blocks are reduced on the threads
+/// of the given pool, by the clone for active_isa() (see isa.h),
+/// which computes the same result.
+template <typename Sequence, typename T, typename BinaryOp, typename UnaryOp>
+T transform_reduce(thread_pool& pool, Sequence&& seq, T init, BinaryOp op, UnaryOp f) {
+    using std::begin;
+    using std::end;
+    using iterator_category =
+        typename std::iterator_traits<decltype(begin(seq))>::iterator_category;
+    static_assert(
+        std::is_convertible_v<iterator_category, std::random_access_iterator_tag>,
+        "transform_reduce needs a random access sequence");
+    const auto size = end(seq) - begin(seq);
+    if (size <= 0) {
+        return init;
+    }
+    const auto first = impl::as_offset(begin(seq));
+    const auto total = static_cast<std::size_t>(size);
+    const auto blocks = (total + impl::reduce_block_size - 1) / impl::reduce_block_size;
+    std::vector<T> partials(blocks, init);
+    // Blocks are already large enough to be scheduled one by one.
+    impl::parallel_for(
+        pool, blocks,
+        [&](std::size_t lo, std::size_t hi) {
+            impl::dispatch([&] {
+                for (auto b = lo; b < hi; ++b) {
+                    partials[b] = impl::block_reduce<T>(
+                        first, b * impl::reduce_block_size,
+                        std::min(total, (b + 1) * impl::reduce_block_size), op, f,
+                        std::make_index_sequence<impl::reduce_lanes>{});
+                }
+            });
+        },
+        1);
+    return op(std::move(init), impl::tree_reduce(partials.data(), blocks, op));
+}
+
+template <typename Sequence, typename T, typename BinaryOp, typename UnaryOp>
+T transform_reduce(Sequence&& seq, T init, BinaryOp op, UnaryOp f) {
+    return transform_reduce(default_thread_pool(), std::forward<Sequence>(seq),
+                            std::move(init), std::move(op), std::move(f));
+}
+
+/// reduce is transform_reduce with no transformation at all: the
+/// elements of seq must be convertible to T. It is meant for single
+/// sequences; zipped ones usually need transform_reduce to turn
+/// their tuples into something reducible.
+template <typename Sequence, typename T, typename BinaryOp>
+T reduce(thread_pool& pool, Sequence&& seq, T init, BinaryOp op) {
+    return transform_reduce(pool, std::forward<Sequence>(seq), std::move(init),
+                            std::move(op), [](auto&& e) -> T { return e; });
+}
+
+template <typename Sequence, typename T, typename BinaryOp = std::plus<>>
+T reduce(Sequence&& seq, T init, BinaryOp op = {}) {
+    return reduce(default_thread_pool(), std::forward<Sequence>(seq), std::move(init),
+                  std::move(op));
+}
+
+}  // namespace zip
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef ZIP_PARALLEL_H_INCLUDED_20261017
+#define ZIP_PARALLEL_H_INCLUDED_20261017
+
+#include <zip.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zip {
+
+/// thread_pool is a fixed set of worker threads that cooperatively
+/// run bulk jobs, i.e. a number of independent tasks identified by
+/// their index. When a job is submitted, its tasks are dealt out in
+/// contiguous ranges, one per participating thread: each thread pops
+/// tasks from the front of its own range and, once that is exhausted,
+/// steals from the back of the other threads' ranges. The submitting
+/// thread always takes part in the job, so a pool without workers
+/// just runs everything serially on the caller.
+class thread_pool {
+   public:
+    explicit thread_pool(std::size_t workers = default_workers())
+        : m_slots{std::make_unique<slot[]>(workers + 1)} {
+        m_workers.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) {
+            m_workers.emplace_back([this, i] { worker_loop(i + 1); });
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool(thread_pool&&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+    thread_pool& operator=(thread_pool&&) = delete;
+
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock{m_lock};
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto&& w : m_workers) {
+            w.join();
+        }
+    }
+
+    /// Number of threads taking part in a job, including the caller.
+    std::size_t concurrency() const noexcept { return m_workers.size() + 1; }
+
+    /// Runs task(i) for every i in [0, tasks) and blocks until all of
+    /// them are done. Tasks may run concurrently and in any order.
+    /// Jobs submitted from within a task run inline on the calling
+    /// thread. If any task throws, the first exception is rethrown
+    /// to the caller once the job is over.
+    template <typename Task>
+    void run(std::size_t tasks, Task&& task) {
+        if (tasks == 0) {
+            return;
+        }
+        if (tasks == 1 || m_workers.empty() || in_job()) {
+            for (std::size_t i = 0; i < tasks; ++i) {
+                task(i);
+            }
+            return;
+        }
+        std::lock_guard<std::mutex> submit{m_submit};
+        {
+            // Workers that woke up too late for the previous job may
+            // still be looking for tasks: let them go first.
+            std::unique_lock<std::mutex> lock{m_lock};
+            m_done.wait(lock, [this] { return m_active == 0; });
+            const auto n = concurrency();
+            for (std::size_t s = 0; s < n; ++s) {
+                std::lock_guard<std::mutex> slot_lock{m_slots[s].lock};
+                m_slots[s].front = tasks * s / n;
+                m_slots[s].back = tasks * (s + 1) / n;
+            }
+            m_job = job{&invoke<std::remove_reference_t<Task>>,
+                        static_cast<void*>(std::addressof(task))};
+            m_pending.store(tasks, std::memory_order_relaxed);
+            m_error = nullptr;
+            ++m_generation;
+        }
+        m_wake.notify_all();
+        work(0, m_job);
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock{m_lock};
+            m_done.wait(lock, [this] {
+                return m_pending.load(std::memory_order_acquire) == 0 && m_active == 0;
+            });
+            error = std::exchange(m_error, nullptr);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    static std::size_t default_workers() noexcept {
+        const auto hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 0;
+    }
+
+   private:
+    struct job {
+        void (*invoke)(void*, std::size_t);
+        void* task;
+    };
+
+    // Task ranges are guarded by their own lock: contention only
+    // happens when stealing, since tasks are meant to be coarse.
+    struct alignas(64) slot {
+        std::mutex lock;
+        std::size_t front = 0;
+        std::size_t back = 0;
+    };
+
+    template <typename Task>
+    static void invoke(void* task, std::size_t i) {
+        (*static_cast<Task*>(task))(i);
+    }
+
+    static bool& in_job() noexcept {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    bool pop(std::size_t self, std::size_t& i) {
+        std::lock_guard<std::mutex> lock{m_slots[self].lock};
+        if (m_slots[self].front == m_slots[self].back) {
+            return false;
+        }
+        i = m_slots[self].front++;
+        return true;
+    }
+
+    bool steal(std::size_t self, std::size_t& i) {
+        const auto n = concurrency();
+        for (std::size_t k = 1; k < n; ++k) {
+            auto& victim = m_slots[(self + k) % n];
+            std::lock_guard<std::mutex> lock{victim.lock};
+            if (victim.front != victim.back) {
+                i = --victim.back;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(std::size_t self, job j) {
+        in_job() = true;
+        std::size_t i = 0;
+        while (pop(self, i) || steal(self, i)) {
+            try {
+                j.invoke(j.task, i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock{m_lock};
+                if (!m_error) {
+                    m_error = std::current_exception();
+                }
+            }
+            if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock{m_lock};
+                m_done.notify_all();
+            }
+        }
+        in_job() = false;
+    }
+
+    void worker_loop(std::size_t self) {
+        std::size_t seen = 0;
+        for (;;) {
+            job j{};
+            {
+                std::unique_lock<std::mutex> lock{m_lock};
+                m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop) {
+                    return;
+                }
+                seen = m_generation;
+                j = m_job;
+                ++m_active;
+            }
+            work(self, j);
+            {
+                std::lock_guard<std::mutex> lock{m_lock};
+                --m_active;
+            }
+            m_done.notify_all();
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::unique_ptr<slot[]> m_slots;
+    std::mutex m_submit;
+    std::mutex m_lock;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    job m_job{};
+    std::atomic<std::size_t> m_pending{0};
+    std::size_t m_generation = 0;
+    std::size_t m_active = 0;
+    std::exception_ptr m_error;
+    bool m_stop = false;
+};
+
+/// default_thread_pool returns the process-wide pool used by all the
+/// parallel algorithms when no pool is explicitly provided. It is
+/// lazily created on first use with one worker per hardware thread
+/// (the caller being the last one).
+inline thread_pool& default_thread_pool() {
+    static thread_pool pool;
+    return pool;
+}
+
+namespace impl {
+
+// Chunks smaller than this are not worth the scheduling overhead.
+inline constexpr std::size_t min_chunk_size = 4096;
+
+// Oversubscription factor: the more chunks per thread, the more
+// room for stealing to balance uneven chunks.
+inline constexpr std::size_t chunks_per_thread = 4;
+
+// chunk_count is the number of chunks an iteration space of the
+// given size is split into when run on pool, none of them (but the
+// only one) smaller than grain.
+inline std::size_t chunk_count(const thread_pool& pool, std::size_t size,
+                               std::size_t grain = min_chunk_size) noexcept {
+    return std::max<std::size_t>(
+        1, std::min(size / grain, pool.concurrency() * chunks_per_thread));
+}
+
+// grain_size is the smallest number of elements of a sequence worth a
+// chunk of their own: rows are cheap, but the elements of chunks()
+// are themselves many rows, so that a single one is enough.
+template <typename Sequence>
+inline constexpr std::size_t grain_size = min_chunk_size;
+
+template <typename Iterator>
+inline constexpr std::size_t grain_size<slice<chunk_iterator<Iterator>>> = 1;
+
+// parallel_for splits [0, size) into contiguous chunks of at least
+// grain iterations and calls body(first, last) on each of them from
+// the pool's threads.
+template <typename Size, typename Body>
+void parallel_for(thread_pool& pool, Size size, Body&& body,
+                  std::size_t grain = min_chunk_size) {
+    if (size <= 0) {
+        return;
+    }
+    const auto total = static_cast<std::size_t>(size);
+    const auto chunks = chunk_count(pool, total, grain);
+    pool.run(chunks, [&](std::size_t c) {
+        const auto first = static_cast<Size>(total * c / chunks);
+        const auto last = static_cast<Size>(total * (c + 1) / chunks);
+        body(first, last);
+    });
+}
+
+}  // namespace impl
+
+/// parallel_for_each applies f to every element of the random access
+/// sequence seq (usually a zip_view), splitting the iteration space
+/// in chunks that get scheduled on the threads of the given pool.
+/// Zipped iterators are turned into offset_iterators so that each
+/// chunk boils down to a loop with a single induction variable, as
+/// friendly to auto-vectorisers as the serial one.
+/// Since f is invoked concurrently, it must be safe to do so.
+template <typename Sequence, typename UnaryOp>
+void parallel_for_each(thread_pool& pool, Sequence&& seq, UnaryOp f) {
+    using std::begin;
+    using std::end;
+    using iterator_category =
+        typename std::iterator_traits<decltype(begin(seq))>::iterator_category;
+    static_assert(
+        std::is_convertible_v<iterator_category, std::random_access_iterator_tag>,
+        "parallel_for_each needs a random access sequence");
+    const auto size = end(seq) - begin(seq);
+    const auto first = impl::as_offset(begin(seq));
+    impl::parallel_for(
+        pool, size,
+        [&](auto lo, auto hi) {
+            for (auto it = first + lo, last = first + hi; it != last; ++it) {
+                f(*it);
+            }
+        },
+        impl::grain_size<std::remove_cv_t<std::remove_reference_t<Sequence>>>);
+}
+
+template <typename Sequence, typename UnaryOp>
+void parallel_for_each(Sequence&& seq, UnaryOp f) {
+    parallel_for_each(default_thread_pool(), std::forward<Sequence>(seq), std::move(f));
+}
+
+}  // namespace zip
+
+#endif
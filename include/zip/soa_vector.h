@@ -0,0 +1,369 @@
+#ifndef ZIP_SOA_VECTOR_H_INCLUDED_20261017
+#define ZIP_SOA_VECTOR_H_INCLUDED_20261017
+
+#include <zip.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace zip {
+
+/// Alignment of every column of a soa_vector: one cache line, which
+/// is also enough for the widest SIMD registers around.
+inline constexpr std::size_t soa_alignment = 64;
+
+/// soa_vector is an owning structure-of-arrays container: it stores
+/// one column per element type, all of them carved out of a single
+/// soa_alignment-aligned allocation, so that they grow together and
+/// every column starts on its own cache line.
+/// Elements are inserted and accessed as tuples, and iterating over
+/// the container yields the same tuples of references as zip():
+/// begin()/end() are offset_iterators walking the columns through
+/// plain pointers.
+template <typename... Ts>
+class soa_vector {
+    static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+    static_assert(((alignof(Ts) <= soa_alignment) && ...),
+                  "over-aligned column types are not supported");
+    static_assert(((std::is_object_v<Ts> && !std::is_const_v<Ts>) && ...),
+                  "soa_vector columns must be non-const object types");
+
+   public:
+    using value_type = std::tuple<Ts...>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = offset_iterator<Ts*...>;
+    using const_iterator = offset_iterator<const Ts*...>;
+    using reference = typename iterator::reference;
+    using const_reference = typename const_iterator::reference;
+
+    soa_vector() noexcept = default;
+
+    explicit soa_vector(size_type count) { resize(count); }
+
+    soa_vector(std::initializer_list<value_type> init) {
+        reserve(std::size(init));
+        for (auto&& value : init) {
+            push_back(value);
+        }
+    }
+
+    soa_vector(const soa_vector& other) {
+        reserve(other.size());
+        for (auto&& value : other) {
+            emplace_back_from(value);
+        }
+    }
+
+    soa_vector(soa_vector&& other) noexcept { swap(other); }
+
+    soa_vector& operator=(soa_vector other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~soa_vector() {
+        clear();
+        deallocate(m_storage);
+    }
+
+    size_type size() const noexcept { return m_size; }
+
+    size_type capacity() const noexcept { return m_capacity; }
+
+    bool empty() const noexcept { return m_size == 0; }
+
+    /// Pointer to the (soa_alignment-aligned) I-th column.
+    template <std::size_t I>
+    auto* data() noexcept {
+        return std::get<I>(m_columns);
+    }
+
+    template <std::size_t I>
+    const auto* data() const noexcept {
+        return std::get<I>(m_columns);
+    }
+
+    iterator begin() noexcept { return std::make_from_tuple<iterator>(m_columns); }
+
+    iterator end() noexcept { return begin() + static_cast<difference_type>(m_size); }
+
+    const_iterator begin() const noexcept { return cbegin(); }
+
+    const_iterator end() const noexcept { return cend(); }
+
+    const_iterator cbegin() const noexcept {
+        return std::make_from_tuple<const_iterator>(m_columns);
+    }
+
+    const_iterator cend() const noexcept {
+        return cbegin() + static_cast<difference_type>(m_size);
+    }
+
+    reference operator[](size_type pos) noexcept {
+        return begin()[static_cast<difference_type>(pos)];
+    }
+
+    const_reference operator[](size_type pos) const noexcept {
+        return cbegin()[static_cast<difference_type>(pos)];
+    }
+
+    reference back() noexcept { return (*this)[m_size - 1]; }
+
+    const_reference back() const noexcept { return (*this)[m_size - 1]; }
+
+    /// Grows the storage of all the columns at once so that they can
+    /// hold at least new_capacity elements.
+    void reserve(size_type new_capacity) {
+        if (new_capacity > m_capacity) {
+            reallocate(new_capacity);
+        }
+    }
+
+    void resize(size_type count) {
+        if (count < m_size) {
+            destroy(count, m_size);
+            m_size = count;
+            return;
+        }
+        reserve(count);
+        while (m_size < count) {
+            emplace_back();
+        }
+    }
+
+    void clear() noexcept {
+        destroy(0, m_size);
+        m_size = 0;
+    }
+
+    void push_back(const value_type& value) { emplace_back_from(value); }
+
+    void push_back(value_type&& value) { emplace_back_from(std::move(value)); }
+
+    /// Appends an element whose columns are constructed from the
+    /// corresponding args, or value-initialised when no args are
+    /// given at all.
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == 0 || sizeof...(Args) == sizeof...(Ts),
+                      "emplace_back needs exactly one argument per column");
+        if constexpr (sizeof...(Args) == 0) {
+            return emplace_back_from(std::tuple<>{});
+        } else {
+            return emplace_back_from(std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+    }
+
+    void pop_back() noexcept {
+        --m_size;
+        destroy(m_size, m_size + 1);
+    }
+
+    void swap(soa_vector& other) noexcept {
+        std::swap(m_storage, other.m_storage);
+        std::swap(m_columns, other.m_columns);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+    }
+
+    friend void swap(soa_vector& lhs, soa_vector& rhs) noexcept { lhs.swap(rhs); }
+
+   private:
+    using columns = std::tuple<Ts*...>;
+    using indexes = std::index_sequence_for<Ts...>;
+
+    // Columns are padded to soa_alignment anyway: the first allocation
+    // is sized so that the widest column fills a whole cache line.
+    static constexpr size_type min_capacity =
+        std::max<size_type>(1, soa_alignment / std::max({sizeof(Ts)...}));
+
+    static constexpr size_type round_up(size_type bytes) noexcept {
+        return (bytes + soa_alignment - 1) / soa_alignment * soa_alignment;
+    }
+
+    // Columns are laid out one after the other, each one padded to a
+    // multiple of soa_alignment so that the next one stays aligned.
+    static constexpr size_type storage_size(size_type capacity) noexcept {
+        return (round_up(capacity * sizeof(Ts)) + ...);
+    }
+
+    template <std::size_t... Is>
+    static columns layout(std::byte* storage, size_type capacity,
+                          std::index_sequence<Is...>) noexcept {
+        size_type offset = 0;
+        columns ret{};
+        ((std::get<Is>(ret) = reinterpret_cast<std::tuple_element_t<Is, value_type>*>(
+              storage + offset),
+          offset += round_up(capacity * sizeof(std::tuple_element_t<Is, value_type>))),
+         ...);
+        return ret;
+    }
+
+    static std::byte* allocate(size_type capacity) {
+        return static_cast<std::byte*>(
+            ::operator new(storage_size(capacity), std::align_val_t{soa_alignment}));
+    }
+
+    static void deallocate(std::byte* storage) noexcept {
+        if (storage) {
+            ::operator delete(storage, std::align_val_t{soa_alignment});
+        }
+    }
+
+    void destroy(size_type first, size_type last) noexcept {
+        destroy_columns(m_columns, first, last, indexes{});
+    }
+
+    template <std::size_t... Is>
+    static void destroy_columns(const columns& cols, size_type first, size_type last,
+                                std::index_sequence<Is...>) noexcept {
+        (std::destroy(std::get<Is>(cols) + first, std::get<Is>(cols) + last), ...);
+    }
+
+    // Destroys the element at pos in the first count columns only,
+    // used to roll back a partially constructed element.
+    template <std::size_t... Is>
+    static void destroy_partial(const columns& cols, size_type pos, std::size_t count,
+                                std::index_sequence<Is...>) noexcept {
+        ((Is < count ? std::destroy_at(std::get<Is>(cols) + pos) : void()), ...);
+    }
+
+    // Same as above for whole columns, used to roll back a partially
+    // relocated storage block.
+    template <std::size_t... Is>
+    void destroy_partial_columns(const columns& cols, std::size_t count,
+                                 std::index_sequence<Is...>) noexcept {
+        ((Is < count ? std::destroy(std::get<Is>(cols), std::get<Is>(cols) + m_size)
+                     : void()),
+         ...);
+    }
+
+    template <typename Tuple>
+    reference emplace_back_from(Tuple&& args) {
+        if (m_size == m_capacity) {
+            reallocate_back(std::max(min_capacity, 2 * m_capacity),
+                            std::forward<Tuple>(args));
+        } else {
+            construct(m_columns, m_size, std::forward<Tuple>(args), indexes{});
+        }
+        return (*this)[m_size++];
+    }
+
+    // Constructs the element at pos of cols column by column: if any
+    // column throws, the ones already constructed are destroyed.
+    template <typename Tuple, std::size_t... Is>
+    static void construct(const columns& cols, size_type pos, Tuple&& args,
+                          std::index_sequence<Is...>) {
+        std::size_t constructed = 0;
+        try {
+            ((construct_column<Is>(cols, pos, std::forward<Tuple>(args)), ++constructed),
+             ...);
+        } catch (...) {
+            destroy_partial(cols, pos, constructed, indexes{});
+            throw;
+        }
+    }
+
+    template <std::size_t I, typename Tuple>
+    static void construct_column(const columns& cols, size_type pos, Tuple&& args) {
+        using column_type = std::tuple_element_t<I, value_type>;
+        auto* where = static_cast<void*>(std::get<I>(cols) + pos);
+        if constexpr (std::tuple_size_v<std::remove_reference_t<Tuple>> == 0) {
+            ::new (where) column_type();
+        } else {
+            ::new (where) column_type(std::get<I>(std::forward<Tuple>(args)));
+        }
+    }
+
+    // Moves all the columns to a new block, or copies them when moving
+    // may throw, so that a failure leaves the container untouched.
+    void reallocate(size_type new_capacity) {
+        auto* storage = allocate(new_capacity);
+        auto cols = layout(storage, new_capacity, indexes{});
+        try {
+            relocate(cols, indexes{});
+        } catch (...) {
+            deallocate(storage);
+            throw;
+        }
+        adopt(storage, cols, new_capacity);
+    }
+
+    // Same as above, also constructing the element past the last one
+    // from args. It is built in the new block before the old one is
+    // released, since args may refer to elements of the container.
+    template <typename Tuple>
+    void reallocate_back(size_type new_capacity, Tuple&& args) {
+        auto* storage = allocate(new_capacity);
+        auto cols = layout(storage, new_capacity, indexes{});
+        try {
+            construct(cols, m_size, std::forward<Tuple>(args), indexes{});
+        } catch (...) {
+            deallocate(storage);
+            throw;
+        }
+        try {
+            relocate(cols, indexes{});
+        } catch (...) {
+            destroy_columns(cols, m_size, m_size + 1, indexes{});
+            deallocate(storage);
+            throw;
+        }
+        adopt(storage, cols, new_capacity);
+    }
+
+    // Releases the current block for storage, laid out as cols, where
+    // the elements have been relocated.
+    void adopt(std::byte* storage, const columns& cols, size_type new_capacity) noexcept {
+        const auto size = m_size;
+        clear();
+        deallocate(m_storage);
+        m_storage = storage;
+        m_columns = cols;
+        m_size = size;
+        m_capacity = new_capacity;
+    }
+
+    template <std::size_t... Is>
+    void relocate(const columns& to, std::index_sequence<Is...>) {
+        std::size_t relocated = 0;
+        try {
+            ((relocate_column(std::get<Is>(m_columns), std::get<Is>(to)), ++relocated),
+             ...);
+        } catch (...) {
+            destroy_partial_columns(to, relocated, indexes{});
+            throw;
+        }
+    }
+
+    // Moving a column is only safe when no later column can fail,
+    // otherwise the moved-from elements would be lost on rollback.
+    static constexpr bool nothrow_relocatable =
+        (std::is_nothrow_move_constructible_v<Ts> && ...);
+
+    template <typename T>
+    void relocate_column(T* from, T* to) {
+        if constexpr (nothrow_relocatable || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(from, m_size, to);
+        } else {
+            std::uninitialized_copy_n(from, m_size, to);
+        }
+    }
+
+    std::byte* m_storage = nullptr;
+    columns m_columns{};
+    size_type m_size = 0;
+    size_type m_capacity = 0;
+};
+
+}  // namespace zip
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef ZIP_STREAM_H_INCLUDED_20261017
+#define ZIP_STREAM_H_INCLUDED_20261017
+
+#include <zip.h>
+#include <zip/soa_vector.h>
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace zip {
+
+/// stream_view is the single-pass range returned by stream(). It pulls
+/// rows from its sources into a soa_vector, one block at a time, and
+/// yields each block as a slice of offset_iterators over the buffered
+/// columns. Pulling the next block overwrites the previous one.
+template <typename... Sequences>
+class stream_view {
+    template <typename Sequence>
+    using source_end_t = decltype(std::end(std::declval<Sequence&>()));
+
+    template <typename Sequence>
+    using source_value_t =
+        typename std::iterator_traits<sequence_iterator_t<Sequence>>::value_type;
+
+    using indexes = std::index_sequence_for<Sequences...>;
+
+   public:
+    using buffer_type = soa_vector<source_value_t<Sequences>...>;
+    using chunk_type = slice<typename buffer_type::iterator>;
+
+    class iterator {
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = chunk_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = chunk_type;
+        using pointer = void;
+
+        iterator() noexcept = default;
+
+        explicit iterator(stream_view* view) noexcept : m_view{view} {}
+
+        reference operator*() const noexcept { return m_view->chunk(); }
+
+        iterator& operator++() {
+            m_view->fill(indexes{});
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        // All the iterators past the last block compare equal, which is
+        // what ends the traversal: there is no other position to tell.
+        friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept {
+            return lhs.done() == rhs.done();
+        }
+
+        friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+       private:
+        bool done() const noexcept { return !m_view || m_view->m_rows == 0; }
+
+        stream_view* m_view = nullptr;
+    };
+
+    stream_view(std::size_t n, Sequences&... seqs)
+        : m_firsts{std::begin(seqs)...}, m_lasts{std::end(seqs)...}, m_buffer(n) {}
+
+    /// Pulls the first block: a stream_view can only be walked once.
+    iterator begin() {
+        if (!m_started) {
+            m_started = true;
+            fill(indexes{});
+        }
+        return iterator{this};
+    }
+
+    iterator end() noexcept { return iterator{}; }
+
+   private:
+    chunk_type chunk() noexcept {
+        return {m_buffer.begin(),
+                m_buffer.begin() + static_cast<std::ptrdiff_t>(m_rows)};
+    }
+
+    // Rows are copied one at a time, each of them only once all the
+    // sources have one to give, so that the shortest source ends the
+    // stream without any other source being read past that row.
+    template <std::size_t... Is>
+    void fill(std::index_sequence<Is...>) {
+        m_rows = 0;
+        while (m_rows < m_buffer.size() &&
+               ((std::get<Is>(m_firsts) != std::get<Is>(m_lasts)) && ...)) {
+            ((m_buffer.template data<Is>()[m_rows] = *std::get<Is>(m_firsts),
+              ++std::get<Is>(m_firsts)),
+             ...);
+            ++m_rows;
+        }
+    }
+
+    std::tuple<sequence_iterator_t<Sequences>...> m_firsts;
+    std::tuple<source_end_t<Sequences>...> m_lasts;
+    buffer_type m_buffer;
+    std::size_t m_rows = 0;
+    bool m_started = false;
+};
+
+/// stream zips sequences whose iterators may be mere input iterators,
+/// e.g. std::istream_iterators, which zip() does not accept since its
+/// views can be walked several times. Rows are pulled from all the
+/// sources in lockstep, n at a time, into contiguous column buffers:
+/// iterating over the stream yields each block as a slice over these,
+/// so that kernels run the same vectorisable loops as over a zip of
+/// vectors, without the whole streams ever being materialised:
+///
+///     for (auto&& block : zip::stream(4096, ids, weights)) {
+///         for (auto&& [id, weight] : block) { ... }
+///     }
+///
+/// The stream stops with its shortest source. Sources are walked
+/// through copies of their iterators, the sequences themselves must
+/// outlive the stream; their value types must be default
+/// constructible and copy assignable. n must be positive.
+template <typename... Sequences>
+auto stream(std::size_t n, Sequences&&... seqs) {
+    static_assert(sizeof...(Sequences) > 0, "stream needs at least one source");
+    assert(n > 0);
+    return stream_view<std::remove_reference_t<Sequences>...>{n, seqs...};
+}
+
+}  // namespace zip
+
+#endif
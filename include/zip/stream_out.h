@@ -0,0 +1,201 @@
+#ifndef ZIP_STREAM_OUT_H_INCLUDED_20261017
+#define ZIP_STREAM_OUT_H_INCLUDED_20261017
+
+#include <zip.h>
+#include <zip/expr.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace zip {
+
+namespace impl {
+
+// Width of the non-temporal stores, which must be aligned on it.
+inline constexpr std::size_t stream_out_width = 16;
+
+// Bytes written to each column at least by a group of rows.
+inline constexpr std::size_t stream_out_bytes = 64;
+
+// Rows evaluated at once by a streaming assign: the fewest making a
+// whole number of cache lines in every column, e.g. 16 rows of floats,
+// 64 of chars. Such a group is small enough to stay in L1, while
+// being evaluated with vector instructions, and starting from a row
+// aligned on a store, so does the next one.
+template <typename... Ts>
+inline constexpr std::ptrdiff_t stream_out_rows = static_cast<std::ptrdiff_t>(
+    std::max({stream_out_bytes / std::gcd(stream_out_bytes, sizeof(Ts))...}));
+
+template <typename T>
+bool is_stream_aligned(const T* ptr) noexcept {
+    return reinterpret_cast<std::uintptr_t>(ptr) % stream_out_width == 0;
+}
+
+// stream_store copies the Rows elements at src to dst, which is
+// aligned on a store when stream is set, bypassing the caches with
+// non-temporal stores. Otherwise, and for elements that are not
+// trivially copyable or targets without SSE2, it is a regular copy.
+template <std::ptrdiff_t Rows, typename T>
+void stream_store(T* dst, const T* src, [[maybe_unused]] bool stream) noexcept(
+    std::is_nothrow_copy_assignable_v<T>) {
+#if defined(__SSE2__)
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (stream) {
+            constexpr auto stores = Rows * sizeof(T) / stream_out_width;
+            auto* to = reinterpret_cast<__m128i*>(dst);
+            const auto* from = reinterpret_cast<const __m128i*>(src);
+            for (std::size_t k = 0; k < stores; ++k) {
+                _mm_stream_si128(to + k, _mm_loadu_si128(from + k));
+            }
+            return;
+        }
+    }
+#endif
+    std::copy(src, src + Rows, dst);
+}
+
+// Orders the non-temporal stores issued so far before any later store,
+// so that other threads see the output once assign returns.
+inline void stream_fence() noexcept {
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+}
+
+}  // namespace impl
+
+/// stream_out_view is the write-only output returned by stream_out(),
+/// only meant to be handed to assign().
+template <typename... Ts>
+class stream_out_view {
+   public:
+    using size_type = std::size_t;
+
+    constexpr explicit stream_out_view(size_type size, Ts*... columns) noexcept
+        : m_columns{columns...}, m_size{size} {}
+
+    constexpr size_type size() const noexcept { return m_size; }
+
+    /// Pointer to the first element of column I.
+    template <std::size_t I>
+    constexpr auto data() const noexcept {
+        return std::get<I>(m_columns);
+    }
+
+   private:
+    std::tuple<Ts*...> m_columns;
+    size_type m_size;
+};
+
+/// stream_out zips contiguous columns (vectors, arrays, soa_vector
+/// columns...) into an output for assign() that writes them with
+/// non-temporal stores: rows go straight to memory instead of
+/// evicting the working set from the caches, and without the
+/// destination lines being read first. This is meant to materialise
+/// results much larger than the last level cache, which are not read
+/// back right away:
+///
+///     zip::assign(zip::stream_out(x, y, z), zip::expr(a, b)(kernel));
+///
+/// Smaller outputs are better off written through the caches, by the
+/// regular assign() over a zip of the same columns.
+template <typename... Sequences>
+constexpr auto stream_out(Sequences&&... seqs) {
+    static_assert(sizeof...(Sequences) > 0, "stream_out needs at least one column");
+    static_assert((is_contiguous_sequence_v<std::remove_reference_t<Sequences>> && ...),
+                  "stream_out needs contiguous sequences");
+    using std::data;
+    using std::size;
+    const auto rows = std::min({static_cast<std::size_t>(size(seqs))...});
+    return stream_out_view<std::remove_reference_t<decltype(*data(seqs))>...>{
+        rows, data(seqs)...};
+}
+
+namespace impl {
+
+// Rows go through three stages: a head of regular assignments up to
+// the first row aligned on a store in the first column, a body
+// streamed a group of rows at a time and a tail shorter than a group,
+// assigned again. Columns not aligned like the first one, which have
+// no common aligned row with it, are assigned all along.
+template <typename Source, typename... Ts, std::size_t... Is>
+void stream_assign(const stream_out_view<Ts...>& out, const Source& src,
+                   std::index_sequence<Is...>) {
+    using std::begin;
+    using std::end;
+    constexpr auto group = stream_out_rows<Ts...>;
+    const auto size = std::min(static_cast<std::ptrdiff_t>(out.size()),
+                               static_cast<std::ptrdiff_t>(end(src) - begin(src)));
+    auto first = as_offset(begin(src));
+    auto dst = make_iterator(offset_iterator_tag{}, out.template data<Is>()...);
+    auto assign_row = [&](std::ptrdiff_t i) {
+        if constexpr (sizeof...(Ts) == 1) {
+            out.template data<0>()[i] = first[i];
+        } else {
+            dst[i] = first[i];
+        }
+    };
+
+    std::ptrdiff_t i = 0;
+    for (; i < size && !is_stream_aligned(out.template data<0>() + i); ++i) {
+        assign_row(i);
+    }
+    const bool stream[] = {is_stream_aligned(out.template data<Is>() + i)...};
+    std::tuple<std::array<Ts, group>...> rows;
+    auto row = make_iterator(offset_iterator_tag{}, std::get<Is>(rows).data()...);
+    for (; i + group <= size; i += group) {
+        for (std::ptrdiff_t j = 0; j < group; ++j) {
+            if constexpr (sizeof...(Ts) == 1) {
+                std::get<0>(rows)[static_cast<std::size_t>(j)] = first[i + j];
+            } else {
+                row[j] = first[i + j];
+            }
+        }
+        (stream_store<group>(out.template data<Is>() + i, std::get<Is>(rows).data(),
+                             stream[Is]),
+         ...);
+    }
+    for (; i < size; ++i) {
+        assign_row(i);
+    }
+    stream_fence();
+}
+
+}  // namespace impl
+
+/// assign evaluates the random access sequence src into the columns
+/// of out, just like the regular assign(), streaming them to memory
+/// with non-temporal stores. Rows are evaluated a few at a time into
+/// registers, which are then stored to the columns: the element types
+/// must be default constructible. All the stores are complete by the
+/// time it returns.
+template <typename Source, typename... Ts>
+void assign(const stream_out_view<Ts...>& out, const Source& src) {
+    impl::stream_assign(out, src, std::index_sequence_for<Ts...>{});
+}
+
+template <typename Source, typename... Ts>
+void assign(stream_out_view<Ts...>& out, const Source& src) {
+    impl::stream_assign(out, src, std::index_sequence_for<Ts...>{});
+}
+
+template <typename Source, typename... Ts>
+void assign(stream_out_view<Ts...>&& out, const Source& src) {
+    impl::stream_assign(out, src, std::index_sequence_for<Ts...>{});
+}
+
+}  // namespace zip
+
+#endif
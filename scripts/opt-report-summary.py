@@ -58,6 +58,9 @@ def transform_clang_optreport(fs):
             vectorization_factor = int(args.setdefault("VectorizationFactor", 0))
             was_successful = vectorization_factor > 0
 
+        # Keep the name of the remark, which tells why a pass missed.
+        args["Remark"] = name
+
         yield Remark(
             type=type, was_successful=was_successful, file=file, line=line, args=args
         )
@@ -0,0 +1,27 @@
+// RUN: mkdir -p %t
+// RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
+// RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %s
+
+#include <zip.h>
+
+#include <vector>
+
+// Each chunk is walked through an offset_iterator, whatever the
+// category of the zipped sequence, so that every pass over it
+// vectorises.
+void Integrate2dFloat(std::vector<float>& x, std::vector<float>& v, float dt) {
+    auto xv = zip::zip(std::random_access_iterator_tag{}, x, v);
+    for (auto&& chunk : zip::chunks(xv, 1024)) {
+        // CHECK: PASSED(loop-vectorize) Chunks.cpp:17
+        for (auto&& e : chunk) {
+            auto&& [value_x, value_v] = e;
+            value_v *= 0.5f;
+        }
+        // CHECK: PASSED(loop-vectorize) Chunks.cpp:22
+        for (auto&& e : chunk) {
+            auto&& [value_x, value_v] = e;
+            value_x += value_v * dt;
+        }
+    }
+}
@@ -0,0 +1,29 @@
+// RUN: mkdir -p %t
+// RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
+// RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %s
+
+#include <zip.h>
+
+#include <cstddef>
+#include <vector>
+
+// The index column is computed from the shared offset: it does not
+// get in the way of vectorisation.
+
+void Shift1dLong(std::vector<long>& x, long base) {
+    // CHECK: PASSED(loop-vectorize) Enumerate.cpp:16
+    for (auto&& e : zip::enumerate(x)) {
+        auto&& [index, value_x] = e;
+        value_x += base - static_cast<long>(index);
+    }
+}
+
+void Ramp2dFloat(std::vector<float>& x, const std::vector<float>& y, float slope) {
+    const zip::counting_sequence<int> ids{};
+    // CHECK: PASSED(loop-vectorize) Enumerate.cpp:25
+    for (auto&& e : zip::zip(x, y, ids)) {
+        auto&& [value_x, value_y, id] = e;
+        value_x = value_y + slope * static_cast<float>(id);
+    }
+}
@@ -0,0 +1,30 @@
+// RUN: mkdir -p %t
+// RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
+// RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %s
+
+#include <zip.h>
+#include <zip/expr.h>
+
+#include <tuple>
+#include <vector>
+
+// All the stages of an expression are inlined into the single loop of
+// assign, which vectorises:
+// CHECK: PASSED(loop-vectorize) expr.h:{{[0-9]+}}
+// CHECK: PASSED(loop-vectorize) expr.h:{{[0-9]+}}
+void Fma3dFloat(std::vector<float>& out, const std::vector<float>& x,
+                const std::vector<float>& y, const std::vector<float>& z) {
+    zip::assign(out, zip::expr(x, y, z)([](float a, float b, float c) {
+                         return a * b + c;
+                     })([](float v) { return v < 0 ? -v : v; })([](float v) {
+                         return v * 0.5f;
+                     }));
+}
+
+void Split2dInt(std::vector<int>& lo, std::vector<int>& hi, const std::vector<int>& x,
+                const std::vector<int>& y) {
+    zip::assign(zip::zip(lo, hi), zip::expr(x, y)([](int a, int b) {
+                    return std::tuple{a < b ? a : b, a < b ? b : a};
+                }));
+}
@@ -0,0 +1,35 @@
+// RUN: mkdir -p %t
+// RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
+// RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %s
+
+#include <zip.h>
+
+#include <vector>
+
+struct Item {
+    float x;
+    float y;
+    float z;
+};
+
+// Members of an array of structs are strided columns: loops over
+// them are vectorised with interleaved loads and stores.
+
+float SumReduce3dFloatFields(const std::vector<Item>& items) {
+    float sum = 0.f;
+    // CHECK: PASSED(loop-vectorize) Fields.cpp:22
+    for (auto&& e : zip::fields(items, &Item::x, &Item::y, &Item::z)) {
+        auto&& [value_x, value_y, value_z] = e;
+        sum += value_x + value_y + value_z;
+    }
+    return sum;
+}
+
+void Axpy2dFloatFields(std::vector<Item>& items, float a) {
+    // CHECK: PASSED(loop-vectorize) Fields.cpp:31
+    for (auto&& e : zip::fields(items, &Item::x, &Item::y)) {
+        auto&& [value_x, value_y] = e;
+        value_y += a * value_x;
+    }
+}
@@ -0,0 +1,68 @@
+// RUN: mkdir -p %t
+// RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
+// RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %anchors %s
+// RUN: %cxx -O3 -ffast-math -DNDEBUG -DNO_RUNTIME_CHECKS -std=c++17 \
+// RUN:      -mllvm -runtime-memory-check-threshold=0 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/strict.yaml -o %t/strict.o -c %s
+// RUN: %opt-report-summary < %t/strict.yaml \
+// RUN:     | %filecheck --check-prefix=STRICT %anchors %s
+// RUN: %opt-report-summary < %t/strict.yaml \
+// RUN:     | %filecheck --check-prefix=RTCHECKS %anchors %s
+
+#include <zip.h>
+#include <zip/algorithm.h>
+#include <zip/expr.h>
+
+#include <tuple>
+#include <vector>
+
+// Columns zipped with no_alias reach the loops of for_each and assign
+// as __restrict parameters, of the function in zip.h holding the loop:
+// write kernels vectorise without runtime overlap checks, even when
+// there are too many columns for checking them all to pay off. assign
+// only knows the output columns, so the compiler may still check them
+// against the columns read by the expression.
+//
+// Runtime checks do not show in the remarks of a loop that vectorises,
+// so the for_each kernels are compiled again with runtime checks
+// disallowed (NO_RUNTIME_CHECKS): a loop needing some then fails to
+// vectorise, for a reason of its own, CantReorderMemOps. The loops of
+// all the kernels are the one of restrict_rows, inlined, so the checks
+// are anchored on its line.
+
+// RTCHECKS-NOT: zip.h:[[RESTRICT_ROWS_LOOP]] {{.*}}Remark=CantReorderMemOps
+
+// CHECK: PASSED(loop-vectorize) zip.h:[[RESTRICT_ROWS_LOOP]]
+// STRICT: PASSED(loop-vectorize) zip.h:[[RESTRICT_ROWS_LOOP]]
+void Axpy(std::vector<float>& out, const std::vector<float>& x,
+          const std::vector<float>& y) {
+    zip::for_each(zip::zip(zip::no_alias, out, x, y), [](auto&& row) {
+        auto&& [o, a, b] = row;
+        o = 2.f * a + b;
+    });
+}
+
+// CHECK: PASSED(loop-vectorize) zip.h:[[RESTRICT_ROWS_LOOP]]
+// STRICT: PASSED(loop-vectorize) zip.h:[[RESTRICT_ROWS_LOOP]]
+void Wide(std::vector<float>& u, std::vector<float>& v, std::vector<float>& w,
+          const std::vector<float>& a, const std::vector<float>& b,
+          const std::vector<float>& c, const std::vector<float>& d,
+          const std::vector<float>& e, const std::vector<float>& f) {
+    zip::for_each(zip::zip(zip::no_alias, u, v, w, a, b, c, d, e, f), [](auto&& row) {
+        auto&& [uu, vv, ww, aa, bb, cc, dd, ee, ff] = row;
+        uu = aa * bb + cc;
+        vv = bb * cc + dd;
+        ww = dd * ee + ff;
+    });
+}
+
+#if !defined(NO_RUNTIME_CHECKS)
+// CHECK: PASSED(loop-vectorize) zip.h:[[RESTRICT_ROWS_LOOP]]
+void MinMax(std::vector<int>& lo, std::vector<int>& hi, const std::vector<int>& x,
+            const std::vector<int>& y) {
+    zip::assign(zip::zip(zip::no_alias, lo, hi), zip::expr(x, y)([](int a, int b) {
+                    return std::tuple{a < b ? a : b, a < b ? b : a};
+                }));
+}
+#endif
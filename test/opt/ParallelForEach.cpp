@@ -0,0 +1,22 @@
+// RUN: mkdir -p %t
+// RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
+// RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %anchors %s
+
+#include <zip.h>
+#include <zip/parallel.h>
+
+#include <vector>
+
+// Each chunk scheduled by parallel_for_each is a loop over an
+// offset_iterator, whatever the category of the zipped sequence:
+// CHECK-NOT: MISSED(loop-vectorize) parallel.h:[[PARALLEL_FOR_EACH_LOOP]]
+// CHECK: PASSED(loop-vectorize) parallel.h:[[PARALLEL_FOR_EACH_LOOP]]
+// CHECK-NOT: MISSED(loop-vectorize) parallel.h:[[PARALLEL_FOR_EACH_LOOP]]
+void Axpy2dInt(std::vector<int>& x, const std::vector<int>& y) {
+    auto xy = zip::zip(std::random_access_iterator_tag{}, x, y);
+    zip::parallel_for_each(xy, [](auto&& e) {
+        auto&& [value_x, value_y] = e;
+        value_x += 2 * value_y;
+    });
+}
@@ -0,0 +1,33 @@
+// RUN: mkdir -p %t
+// RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
+// RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %s
+
+#include <zip.h>
+#include <zip/stream.h>
+
+#include <istream>
+#include <iterator>
+
+struct floats {
+    std::istream_iterator<float> begin() const {
+        return std::istream_iterator<float>{*in};
+    }
+
+    std::istream_iterator<float> end() const { return {}; }
+    std::istream* in;
+};
+
+// Single-pass sources are buffered into contiguous columns, so that
+// kernels over each block vectorise as they do over a zip of vectors.
+float Dot2dStream(std::istream& x, std::istream& y) {
+    float sum = 0;
+    for (auto&& block : zip::stream(4096, floats{&x}, floats{&y})) {
+        // CHECK: PASSED(loop-vectorize) Stream.cpp:27
+        for (auto&& e : block) {
+            auto&& [value_x, value_y] = e;
+            sum += value_x * value_y;
+        }
+    }
+    return sum;
+}
@@ -2,16 +2,21 @@
 // RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
 // RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
 // RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %s
+// RUN: %cxx -O3 -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/strict.yaml -o %t/strict.o -c %s
+// RUN: %opt-report-summary < %t/strict.yaml | %filecheck --check-prefix=STRICT %s
 
 #include <zip.h>
+#include <zip/numeric.h>
 
+#include <functional>
 #include <vector>
 
 // Smoke tests: if we cannot auto-vectorize these, we are in big troubles.
 
 int SumReduce1dInt(const std::vector<int>& x) {
     int sum = 0;
-    // CHECK: PASSED(loop-vectorize) SumReduce1d.cpp:15
+    // CHECK: PASSED(loop-vectorize) SumReduce1d.cpp:20
     for (auto it = std::cbegin(x); it != std::cend(x); ++it) {
         sum += *it;
     }
@@ -20,7 +25,7 @@ int SumReduce1dInt(const std::vector<int>& x) {
 
 int SumReduce1dFloat(const std::vector<float>& x) {
     float sum = 0.f;
-    // CHECK: PASSED(loop-vectorize) SumReduce1d.cpp:24
+    // CHECK: PASSED(loop-vectorize) SumReduce1d.cpp:29
     for (auto it = std::cbegin(x); it != std::cend(x); ++it) {
         sum += *it;
     }
@@ -31,7 +36,7 @@ int SumReduce1dFloat(const std::vector<float>& x) {
 
 int SumReduce1dIntZip(const std::vector<int>& x) {
     int sum = 0;
-    // CHECK: PASSED(loop-vectorize) SumReduce1d.cpp:35
+    // CHECK: PASSED(loop-vectorize) SumReduce1d.cpp:40
     for (auto [value] : zip::zip(x)) {
         sum += value;
     }
@@ -40,9 +45,19 @@ int SumReduce1dIntZip(const std::vector<int>& x) {
 
 float SumReduce1dFloatZip(const std::vector<float>& x) {
     float sum = 0.f;
-    // CHECK: PASSED(loop-vectorize) SumReduce1d.cpp:44
+    // CHECK: PASSED(loop-vectorize) SumReduce1d.cpp:49
     for (auto [value] : zip::zip(x)) {
         sum += value;
     }
     return sum;
 }
+
+// Reproducible reductions
+
+// Without -ffast-math, float reductions only vectorize if they do not
+// need reassociating: zip::reduce keeps a fixed set of independent
+// accumulators, which can be vectorized as they are:
+// STRICT: PASSED({{loop-vectorize|slp-vectorizer}}) numeric.h:{{[0-9]+}}
+float SumReduce1dFloatReproducible(const std::vector<float>& x) {
+    return zip::reduce(x, 0.f, std::plus<>{});
+}
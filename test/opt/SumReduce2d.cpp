@@ -2,9 +2,14 @@
 // RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
 // RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
 // RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %s
+// RUN: %cxx -O3 -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/strict.yaml -o %t/strict.o -c %s
+// RUN: %opt-report-summary < %t/strict.yaml | %filecheck --check-prefix=STRICT %s
 
 #include <zip.h>
+#include <zip/numeric.h>
 
+#include <functional>
 #include <vector>
 
 template <typename T>
@@ -17,9 +22,9 @@ Result<int> SumReduce2dInt(const std::vector<int>& x, const std::vector<int>& y)
     int sum_x = 0;
     int sum_y = 0;
 
-    // zip_iterator inferred category is random_access, clang is unable
-    // to vectorize while keeping track of 2 independent iterators:
-    // CHECK: MISSED(loop-vectorize) SumReduce2d.cpp:23
+    // sequences are contiguous, zip_iterator inferred category is offset:
+    // clang is able to vectorize advancing all 2 sequences at once:
+    // CHECK: PASSED(loop-vectorize) SumReduce2d.cpp:28
     for (auto [value_x, value_y] : zip::zip(x, y)) {
         sum_x += value_x;
         sum_y += value_y;
@@ -32,10 +37,10 @@ Result<int> SumReduce2dIntOffset(const std::vector<int>& x, const std::vector<in
     int sum_x = 0;
     int sum_y = 0;
 
-    // offset_iterator must be requested explicitly, but allows
+    // offset_iterator can be requested explicitly as well, it allows
     // clang to vectorize since it advances all iterators using
     // a single induction variable:
-    // CHECK: PASSED(loop-vectorize) SumReduce2d.cpp:39
+    // CHECK: PASSED(loop-vectorize) SumReduce2d.cpp:44
     for (auto [value_x, value_y] : zip::zip(zip::offset_iterator_tag{}, x, y)) {
         sum_x += value_x;
         sum_y += value_y;
@@ -48,9 +53,9 @@ Result<float> SumReduce2dFloat(const std::vector<float>& x, const std::vector<fl
     float sum_x = 0.f;
     float sum_y = 0.f;
 
-    // zip_iterator inferred category is random_access, clang is unable
-    // to vectorize while keeping track of 2 independent iterators:
-    // CHECK: MISSED(loop-vectorize) SumReduce2d.cpp:54
+    // sequences are contiguous, zip_iterator inferred category is offset:
+    // clang is able to vectorize advancing all 2 sequences at once:
+    // CHECK: PASSED(loop-vectorize) SumReduce2d.cpp:59
     for (auto [value_x, value_y] : zip::zip(x, y)) {
         sum_x += value_x;
         sum_y += value_y;
@@ -64,10 +69,10 @@ Result<float> SumReduce2dFloatOffset(const std::vector<float>& x,
     float sum_x = 0.f;
     float sum_y = 0.f;
 
-    // offset_iterator must be requested explicitly, but allows
+    // offset_iterator can be requested explicitly as well, it allows
     // clang to vectorize since it advances all iterators using
     // a single induction variable:
-    // CHECK: PASSED(loop-vectorize) SumReduce2d.cpp:71
+    // CHECK: PASSED(loop-vectorize) SumReduce2d.cpp:76
     for (auto [value_x, value_y] : zip::zip(zip::offset_iterator_tag{}, x, y)) {
         sum_x += value_x;
         sum_y += value_y;
@@ -75,3 +80,15 @@ Result<float> SumReduce2dFloatOffset(const std::vector<float>& x,
 
     return {sum_x, sum_y};
 }
+
+// Without -ffast-math, float reductions only vectorize if they do not
+// need reassociating: zip::transform_reduce keeps a fixed set of
+// independent accumulators, which can be vectorized as they are:
+// STRICT: PASSED({{loop-vectorize|slp-vectorizer}}) numeric.h:{{[0-9]+}}
+float SumReduce2dFloatReproducible(const std::vector<float>& x,
+                                   const std::vector<float>& y) {
+    return zip::transform_reduce(zip::zip(x, y), 0.f, std::plus<>{}, [](auto&& e) {
+        auto&& [value_x, value_y] = e;
+        return value_x + value_y;
+    });
+}
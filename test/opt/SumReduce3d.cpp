@@ -2,9 +2,14 @@
 // RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
 // RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
 // RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %s
+// RUN: %cxx -O3 -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/strict.yaml -o %t/strict.o -c %s
+// RUN: %opt-report-summary < %t/strict.yaml | %filecheck --check-prefix=STRICT %s
 
 #include <zip.h>
+#include <zip/numeric.h>
 
+#include <functional>
 #include <vector>
 
 template <typename T>
@@ -20,9 +25,9 @@ Result<int> SumReduce3dInt(const std::vector<int>& x, const std::vector<int>& y,
     int sum_y = 0;
     int sum_z = 0;
 
-    // zip_iterator inferred category is random_access, clang is unable
-    // to vectorize while keeping track of 3 independent iterators:
-    // CHECK: MISSED(loop-vectorize) SumReduce3d.cpp:26
+    // sequences are contiguous, zip_iterator inferred category is offset:
+    // clang is able to vectorize advancing all 3 sequences at once:
+    // CHECK: PASSED(loop-vectorize) SumReduce3d.cpp:31
     for (auto [value_x, value_y, value_z] : zip::zip(x, y, z)) {
         sum_x += value_x;
         sum_y += value_y;
@@ -38,10 +43,10 @@ Result<int> SumReduce3dIntOffset(const std::vector<int>& x, const std::vector<in
     int sum_y = 0;
     int sum_z = 0;
 
-    // offset_iterator must be requested explicitly, but allows
+    // offset_iterator can be requested explicitly as well, it allows
     // clang to vectorize since it advances all iterators using
     // a single induction variable:
-    // CHECK: PASSED(loop-vectorize) SumReduce3d.cpp:45
+    // CHECK: PASSED(loop-vectorize) SumReduce3d.cpp:50
     for (auto [value_x, value_y, value_z] :
          zip::zip(zip::offset_iterator_tag{}, x, y, z)) {
         sum_x += value_x;
@@ -58,9 +63,9 @@ Result<float> SumReduce3dFloat(const std::vector<float>& x, const std::vector<fl
     float sum_y = 0.f;
     float sum_z = 0.f;
 
-    // zip_iterator inferred category is random_access, clang is unable
-    // to vectorize while keeping track of 3 independent iterators:
-    // CHECK: MISSED(loop-vectorize) SumReduce3d.cpp:64
+    // sequences are contiguous, zip_iterator inferred category is offset:
+    // clang is able to vectorize advancing all 3 sequences at once:
+    // CHECK: PASSED(loop-vectorize) SumReduce3d.cpp:69
     for (auto [value_x, value_y, value_z] : zip::zip(x, y, z)) {
         sum_x += value_x;
         sum_y += value_y;
@@ -77,10 +82,10 @@ Result<float> SumReduce3dFloatOffset(const std::vector<float>& x,
     float sum_y = 0.f;
     float sum_z = 0.f;
 
-    // offset_iterator must be requested explicitly, but allows
+    // offset_iterator can be requested explicitly as well, it allows
     // clang to vectorize since it advances all iterators using
     // a single induction variable:
-    // CHECK: PASSED(loop-vectorize) SumReduce3d.cpp:84
+    // CHECK: PASSED(loop-vectorize) SumReduce3d.cpp:89
     for (auto [value_x, value_y, value_z] :
          zip::zip(zip::offset_iterator_tag{}, x, y, z)) {
         sum_x += value_x;
@@ -90,3 +95,16 @@ Result<float> SumReduce3dFloatOffset(const std::vector<float>& x,
 
     return {sum_x, sum_y, sum_z};
 }
+
+// Without -ffast-math, float reductions only vectorize if they do not
+// need reassociating: zip::transform_reduce keeps a fixed set of
+// independent accumulators, which can be vectorized as they are:
+// STRICT: PASSED({{loop-vectorize|slp-vectorizer}}) numeric.h:{{[0-9]+}}
+float SumReduce3dFloatReproducible(const std::vector<float>& x,
+                                   const std::vector<float>& y,
+                                   const std::vector<float>& z) {
+    return zip::transform_reduce(zip::zip(x, y, z), 0.f, std::plus<>{}, [](auto&& e) {
+        auto&& [value_x, value_y, value_z] = e;
+        return value_x + value_y + value_z;
+    });
+}
@@ -2,9 +2,14 @@
 // RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
 // RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
 // RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %s
+// RUN: %cxx -O3 -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/strict.yaml -o %t/strict.o -c %s
+// RUN: %opt-report-summary < %t/strict.yaml | %filecheck --check-prefix=STRICT %s
 
 #include <zip.h>
+#include <zip/numeric.h>
 
+#include <functional>
 #include <vector>
 
 template <typename T>
@@ -22,9 +27,9 @@ Result<int> SumReduce4dInt(const std::vector<int>& x, const std::vector<int>& y,
     int sum_z = 0;
     int sum_w = 0;
 
-    // zip_iterator inferred category is random_access, clang is unable
-    // to vectorize while keeping track of 4 parallel iterators:
-    // CHECK: MISSED(loop-vectorize) SumReduce4d.cpp:28
+    // sequences are contiguous, zip_iterator inferred category is offset:
+    // clang is able to vectorize advancing all 4 sequences at once:
+    // CHECK: PASSED(loop-vectorize) SumReduce4d.cpp:33
     for (auto [value_x, value_y, value_z, value_w] : zip::zip(x, y, z, w)) {
         sum_x += value_x;
         sum_y += value_y;
@@ -42,10 +47,10 @@ Result<int> SumReduce4dIntOffset(const std::vector<int>& x, const std::vector<in
     int sum_z = 0;
     int sum_w = 0;
 
-    // offset_iterator must be requested explicitly, but allows
+    // offset_iterator can be requested explicitly as well, it allows
     // clang to vectorize since it advances all iterators using
     // a single induction variable:
-    // CHECK: PASSED(loop-vectorize) SumReduce4d.cpp:49
+    // CHECK: PASSED(loop-vectorize) SumReduce4d.cpp:54
     for (auto [value_x, value_y, value_z, value_w] :
          zip::zip(zip::offset_iterator_tag{}, x, y, z, w)) {
         sum_x += value_x;
@@ -64,9 +69,9 @@ Result<float> SumReduce4dFloat(const std::vector<float>& x, const std::vector<fl
     float sum_z = 0.f;
     float sum_w = 0.f;
 
-    // zip_iterator inferred category is random_access, clang is unable
-    // to vectorize while keeping track of 4 parallel iterators:
-    // CHECK: MISSED(loop-vectorize) SumReduce4d.cpp:70
+    // sequences are contiguous, zip_iterator inferred category is offset:
+    // clang is able to vectorize advancing all 4 sequences at once:
+    // CHECK: PASSED(loop-vectorize) SumReduce4d.cpp:75
     for (auto [value_x, value_y, value_z, value_w] : zip::zip(x, y, z, w)) {
         sum_x += value_x;
         sum_y += value_y;
@@ -86,10 +91,10 @@ Result<float> SumReduce4dFloatOffset(const std::vector<float>& x,
     float sum_z = 0.f;
     float sum_w = 0.f;
 
-    // offset_iterator must be requested explicitly, but allows
+    // offset_iterator can be requested explicitly as well, it allows
     // clang to vectorize since it advances all iterators using
     // a single induction variable:
-    // CHECK: PASSED(loop-vectorize) SumReduce4d.cpp:93
+    // CHECK: PASSED(loop-vectorize) SumReduce4d.cpp:98
     for (auto [value_x, value_y, value_z, value_w] :
          zip::zip(zip::offset_iterator_tag{}, x, y, z, w)) {
         sum_x += value_x;
@@ -100,3 +105,17 @@ Result<float> SumReduce4dFloatOffset(const std::vector<float>& x,
 
     return {sum_x, sum_y, sum_z, sum_w};
 }
+
+// Without -ffast-math, float reductions only vectorize if they do not
+// need reassociating: zip::transform_reduce keeps a fixed set of
+// independent accumulators, which can be vectorized as they are:
+// STRICT: PASSED({{loop-vectorize|slp-vectorizer}}) numeric.h:{{[0-9]+}}
+float SumReduce4dFloatReproducible(const std::vector<float>& x,
+                                   const std::vector<float>& y,
+                                   const std::vector<float>& z,
+                                   const std::vector<float>& w) {
+    return zip::transform_reduce(zip::zip(x, y, z, w), 0.f, std::plus<>{}, [](auto&& e) {
+        auto&& [value_x, value_y, value_z, value_w] = e;
+        return value_x + value_y + value_z + value_w;
+    });
+}
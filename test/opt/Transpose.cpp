@@ -0,0 +1,34 @@
+// RUN: mkdir -p %t
+// RUN: %cxx -O3 -ffast-math -DNDEBUG -std=c++17 -fsave-optimization-record \
+// RUN:      -foptimization-record-file=%t/remarks.yaml -o %t/out.o -c %s
+// RUN: %opt-report-summary < %t/remarks.yaml | %filecheck %s
+
+#include <zip.h>
+#include <zip/algorithm.h>
+
+#include <vector>
+
+struct Item {
+    int x;
+    int y;
+    int z;
+    int w;
+};
+
+// Rows are copied through the column iterators, which walk members
+// known at compile time from a single struct pointer: both
+// directions vectorise with (de)interleaving shuffles.
+// CHECK: PASSED(loop-vectorize) algorithm.h:{{[0-9]+}}
+// CHECK: PASSED(loop-vectorize) algorithm.h:{{[0-9]+}}
+void Scatter4dInt(const std::vector<Item>& aos, std::vector<int>& x, std::vector<int>& y,
+                  std::vector<int>& z, std::vector<int>& w) {
+    zip::scatter_to_columns(zip::fields<&Item::x, &Item::y, &Item::z, &Item::w>(aos),
+                            zip::zip(x, y, z, w));
+}
+
+void Gather4dInt(std::vector<Item>& aos, const std::vector<int>& x,
+                 const std::vector<int>& y, const std::vector<int>& z,
+                 const std::vector<int>& w) {
+    zip::gather_from_columns(zip::zip(x, y, z, w),
+                             zip::fields<&Item::x, &Item::y, &Item::z, &Item::w>(aos));
+}
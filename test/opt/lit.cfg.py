@@ -1,7 +1,33 @@
 import lit.formats
 import os
+import re
 
 config.test_source_root = os.path.dirname(__file__)
 config.name = "zip"
 config.suffixes = [".cpp"]
 config.test_format = lit.formats.ShTest()
+
+# Loops of the headers that tests anchor their checks on, each one
+# being the first for loop after the given text. %anchors defines
+# their line numbers for FileCheck, e.g. [[RESTRICT_ROWS_LOOP]].
+anchors = {
+    "RESTRICT_ROWS_LOOP": ("include/zip.h", "constexpr void restrict_rows("),
+    "PARALLEL_FOR_EACH_LOOP": ("include/zip/parallel.h",
+                               "void parallel_for_each(thread_pool& pool"),
+}
+
+
+def anchor_line(header: str, text: str) -> int:
+    with open(os.path.join(config.zip_src_root, header)) as f:
+        source = f.read()
+    start = source.find(text)
+    loop = re.compile(r"^\s*for \(", re.MULTILINE).search(source, max(start, 0))
+    if start < 0 or not loop:
+        lit_config.fatal(f"no loop after '{text}' in {header}")
+    return source.count("\n", 0, loop.start()) + 1
+
+
+config.substitutions.append((
+    r"%anchors",
+    " ".join(f"-D{name}={anchor_line(*where)}" for name, where in anchors.items()),
+))
@@ -0,0 +1,395 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zip.h>
+#include <zip/algorithm.h>
+#include <zip/parallel.h>
+#include <zip/soa_vector.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+enum class color : signed char { red = -1, green, blue };
+
+}  // namespace
+
+TEST(RadixSort, SignedKeys) {
+    std::vector<int> key{3, -1, 0, -7, 42, 3, std::numeric_limits<int>::min(), 8};
+    std::vector<std::string> payload{"a", "b", "c", "d", "e", "f", "g", "h"};
+    zip::radix_sort<0>(zip::zip(key, payload));
+    EXPECT_EQ(key, (std::vector<int>{std::numeric_limits<int>::min(), -7, -1, 0, 3, 3,
+                                     8, 42}));
+    // Stable: equal keys keep their relative order
+    EXPECT_EQ(payload,
+              (std::vector<std::string>{"g", "d", "b", "c", "a", "f", "h", "e"}));
+}
+
+TEST(RadixSort, KeyColumnAnywhere) {
+    std::deque<double> payload{0.5, 1.5, 2.5};
+    std::vector<std::uint16_t> key{300, 2, 1};
+    zip::radix_sort<1>(zip::zip(payload, key));
+    EXPECT_EQ(key, (std::vector<std::uint16_t>{1, 2, 300}));
+    EXPECT_EQ(payload, (std::deque<double>{2.5, 1.5, 0.5}));
+}
+
+TEST(RadixSort, CompositeKey) {
+    std::vector<color> c{color::blue, color::red, color::blue, color::green, color::red};
+    std::vector<std::int64_t> n{1, 5, 0, 2, -5};
+    std::vector<int> id{0, 1, 2, 3, 4};
+    zip::radix_sort<0, 1>(zip::zip(c, n, id));
+    EXPECT_EQ(id, (std::vector<int>{4, 1, 3, 2, 0}));
+    zip::radix_sort<1, 0>(zip::zip(c, n, id));
+    EXPECT_EQ(id, (std::vector<int>{4, 2, 0, 3, 1}));
+}
+
+TEST(RadixSort, MatchesStableSort) {
+    zip::thread_pool pool{3};
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<std::int32_t> dist{-1000, 1000};
+    std::vector<std::int32_t> key(200000);
+    std::vector<std::size_t> row(std::size(key));
+    std::generate(std::begin(key), std::end(key), [&] { return dist(gen); });
+    std::iota(std::begin(row), std::end(row), std::size_t{0});
+    auto expected_key = key;
+    auto expected_row = row;
+    auto expected = zip::zip(expected_key, expected_row);
+    std::stable_sort(std::begin(expected), std::end(expected),
+                     [](auto&& lhs, auto&& rhs) {
+                         return std::get<0>(lhs) < std::get<0>(rhs);
+                     });
+    zip::radix_sort<0>(pool, zip::zip(key, row));
+    EXPECT_EQ(key, expected_key);
+    EXPECT_EQ(row, expected_row);
+}
+
+TEST(RadixSort, SoaVector) {
+    zip::soa_vector<std::uint8_t, std::string> v{{2, "two"}, {0, "zero"}, {1, "one"}};
+    zip::radix_sort<0>(v);
+    EXPECT_EQ(v[0], std::make_tuple(0, "zero"));
+    EXPECT_EQ(v[1], std::make_tuple(1, "one"));
+    EXPECT_EQ(v[2], std::make_tuple(2, "two"));
+}
+
+TEST(RadixSort, Empty) {
+    std::vector<int> a;
+    std::vector<int> b;
+    zip::radix_sort<0>(zip::zip(a, b));
+    EXPECT_TRUE(a.empty());
+}
+
+namespace {
+
+struct record {
+    std::int64_t id;
+    float x;
+    char tag;
+    double y;
+};
+
+std::vector<record> make_records(std::size_t size) {
+    std::vector<record> ret(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        ret[i] = {static_cast<std::int64_t>(i) * 3, static_cast<float>(i) / 2.f,
+                  static_cast<char>('a' + i % 26), static_cast<double>(i) * 1.5};
+    }
+    return ret;
+}
+
+}  // namespace
+
+TEST(ScatterToColumns, ZipView) {
+    zip::thread_pool pool{3};
+    const auto aos = make_records(10007);
+    std::vector<std::int64_t> id(std::size(aos));
+    std::vector<double> y(std::size(aos));
+    std::vector<char> tag(std::size(aos));
+    zip::scatter_to_columns(pool, zip::fields(aos, &record::id, &record::y, &record::tag),
+                            zip::zip(id, y, tag));
+    for (std::size_t i = 0; i < std::size(aos); ++i) {
+        ASSERT_EQ(id[i], aos[i].id);
+        ASSERT_EQ(y[i], aos[i].y);
+        ASSERT_EQ(tag[i], aos[i].tag);
+    }
+}
+
+TEST(ScatterToColumns, SoaVectorShortest) {
+    const auto aos = make_records(100);
+    zip::soa_vector<float, std::int64_t> soa(60);
+    zip::scatter_to_columns(zip::fields(aos, &record::x, &record::id), soa);
+    EXPECT_EQ(soa.size(), 60);
+    EXPECT_EQ(soa[59], (std::tuple<float, std::int64_t>{29.5f, 177}));
+}
+
+TEST(GatherFromColumns, RoundTrip) {
+    const auto aos = make_records(5000);
+    zip::soa_vector<std::int64_t, float, char, double> soa(std::size(aos));
+    zip::scatter_to_columns(
+        zip::fields<&record::id, &record::x, &record::tag, &record::y>(aos), soa);
+
+    std::vector<record> out(std::size(aos));
+    zip::gather_from_columns(
+        soa, zip::fields(out, &record::id, &record::x, &record::tag, &record::y));
+    for (std::size_t i = 0; i < std::size(aos); ++i) {
+        ASSERT_EQ(out[i].id, aos[i].id);
+        ASSERT_EQ(out[i].x, aos[i].x);
+        ASSERT_EQ(out[i].tag, aos[i].tag);
+        ASSERT_EQ(out[i].y, aos[i].y);
+    }
+}
+
+TEST(GatherFromColumns, Chunk) {
+    std::vector<int> a{1, 2, 3, 4, 5, 6, 7};
+    std::vector<record> out(3);
+    auto chunk = *(std::begin(zip::chunks(zip::zip(a), 3)) + 1);
+    zip::gather_from_columns(chunk, zip::fields(out, &record::id));
+    EXPECT_EQ(out[0].id, 4);
+    EXPECT_EQ(out[2].id, 6);
+}
+
+TEST(ScatterToColumns, DistinctObjects) {
+    // Members of two different arrays, which must not be mistaken for
+    // the members of a single one
+    const auto a = make_records(3000);
+    const auto b = make_records(3001);
+    auto first = zip::make_iterator(
+        zip::offset_iterator_tag{},
+        zip::member_iterator<const record, std::int64_t, &record::id>{a.data()},
+        zip::member_iterator<const record, float, &record::x>{b.data() + 1});
+    std::vector<std::int64_t> id(3000);
+    std::vector<float> x(3000);
+    zip::scatter_to_columns(zip::slice<decltype(first)>{first, first + 3000},
+                            zip::zip(id, x));
+    EXPECT_EQ(id[2999], a[2999].id);
+    EXPECT_EQ(x[2999], b[3000].x);
+}
+
+TEST(FilterCopy, MatchesCopyIf) {
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int> dist{0, 99};
+    for (auto size : {0u, 1u, 255u, 256u, 257u, 1000u}) {
+        for (int threshold : {0, 1, 50, 99, 100}) {
+            std::vector<int> key(size);
+            std::vector<double> value(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                key[i] = dist(gen);
+                value[i] = static_cast<double>(i);
+            }
+            const auto pred = [threshold](auto&& row) {
+                return std::get<0>(row) < threshold;
+            };
+
+            std::vector<int> expected_key(size);
+            std::vector<double> expected_value(size);
+            auto in = zip::zip(key, value);
+            auto expected = zip::zip(expected_key, expected_value);
+            const auto expected_end =
+                std::copy_if(std::begin(in), std::end(in), std::begin(expected), pred);
+
+            std::vector<int> out_key(size, -1);
+            std::vector<double> out_value(size, -1);
+            const auto count = zip::filter_copy(in, pred, zip::zip(out_key, out_value));
+            const auto expected_count = expected_end - std::begin(expected);
+            ASSERT_EQ(count, static_cast<std::size_t>(expected_count));
+            out_key.resize(count);
+            out_value.resize(count);
+            expected_key.resize(count);
+            expected_value.resize(count);
+            EXPECT_EQ(out_key, expected_key);
+            EXPECT_EQ(out_value, expected_value);
+        }
+    }
+}
+
+TEST(FilterCopy, OutputFull) {
+    std::vector<int> x(1000);
+    std::iota(x.begin(), x.end(), 0);
+    std::vector<int> out(10, -1);
+    const auto count = zip::filter_copy(
+        zip::zip(x), [](auto&& row) { return std::get<0>(row) % 3 == 0; }, zip::zip(out));
+    EXPECT_EQ(count, 10);
+    EXPECT_THAT(out, testing::ElementsAre(0, 3, 6, 9, 12, 15, 18, 21, 24, 27));
+}
+
+TEST(FilterCopy, KeepsTheRestOfOut) {
+    // Dense blocks, each one ending with a row that is not selected.
+    std::vector<int> x(1000);
+    std::iota(x.begin(), x.end(), 0);
+    std::vector<int> out(1000, -1);
+    const auto count = zip::filter_copy(
+        zip::zip(x), [](auto&& row) { return std::get<0>(row) % 4 != 3; }, zip::zip(out));
+    ASSERT_EQ(count, 750);
+    EXPECT_EQ(out[749], 998);
+    EXPECT_THAT(std::vector<int>(out.begin() + 750, out.end()), testing::Each(-1));
+}
+
+TEST(Compact, KeepsOrder) {
+    std::vector<int> x(600);
+    std::iota(x.begin(), x.end(), 0);
+    std::vector<std::string> name(x.size());
+    std::transform(x.begin(), x.end(), name.begin(),
+                   [](int i) { return std::to_string(i); });
+    // The first rows are kept, so that compaction starts in place.
+    const auto count = zip::compact(zip::zip(x, name), [](auto&& row) {
+        return std::get<0>(row) < 5 || std::get<0>(row) % 7 == 0;
+    });
+
+    std::vector<int> expected;
+    for (int i = 0; i < 600; ++i) {
+        if (i < 5 || i % 7 == 0) {
+            expected.push_back(i);
+        }
+    }
+    ASSERT_EQ(count, expected.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(x[i], expected[i]);
+        EXPECT_EQ(name[i], std::to_string(expected[i]));
+    }
+}
+
+TEST(Compact, AllOrNothing) {
+    std::vector<int> x{1, 2, 3};
+    EXPECT_EQ(zip::compact(zip::zip(x), [](auto&&) { return true; }), 3);
+    EXPECT_THAT(x, testing::ElementsAre(1, 2, 3));
+    EXPECT_EQ(zip::compact(zip::zip(x), [](auto&&) { return false; }), 0);
+    std::vector<int> empty;
+    EXPECT_EQ(zip::compact(zip::zip(empty), [](auto&&) { return true; }), 0);
+}
+
+TEST(Gather, Rows) {
+    std::vector<int> x(1000);
+    std::vector<std::string> name(x.size());
+    std::iota(x.begin(), x.end(), 0);
+    std::transform(x.begin(), x.end(), name.begin(),
+                   [](int i) { return std::to_string(i); });
+    std::vector<std::size_t> indices(500);
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<std::size_t> dist{0, x.size() - 1};
+    std::generate(indices.begin(), indices.end(), [&] { return dist(gen); });
+
+    std::vector<int> out_x(indices.size());
+    std::vector<std::string> out_name(indices.size());
+    zip::gather(zip::zip(x, name), indices, zip::zip(out_x, out_name));
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        EXPECT_EQ(out_x[i], static_cast<int>(indices[i]));
+        EXPECT_EQ(out_name[i], std::to_string(indices[i]));
+    }
+    // The source is left untouched.
+    EXPECT_EQ(name[42], "42");
+}
+
+TEST(Gather, ShortestOutput) {
+    std::vector<int> x{10, 20, 30};
+    std::vector<int> indices{2, 0, 1, 2};
+    std::vector<int> out(2, -1);
+    zip::gather(zip::zip(x), indices, zip::zip(out));
+    EXPECT_THAT(out, testing::ElementsAre(30, 10));
+}
+
+TEST(PermuteInPlace, MatchesGather) {
+    const std::size_t size = 10000;
+    std::vector<std::uint32_t> perm(size);
+    std::iota(perm.begin(), perm.end(), 0u);
+    std::shuffle(perm.begin(), perm.end(), std::mt19937{7});
+    std::vector<int> x(size);
+    std::vector<double> y(size);
+    std::iota(x.begin(), x.end(), 0);
+    std::iota(y.begin(), y.end(), 0.5);
+
+    std::vector<int> expected_x(size);
+    std::vector<double> expected_y(size);
+    zip::gather(zip::zip(x, y), perm, zip::zip(expected_x, expected_y));
+    zip::permute_in_place(zip::zip(x, y), perm);
+    EXPECT_EQ(x, expected_x);
+    EXPECT_EQ(y, expected_y);
+}
+
+TEST(PermuteInPlace, SoaVector) {
+    zip::soa_vector<int, std::string> v{{1, "one"}, {2, "two"}, {3, "three"}};
+    zip::permute_in_place(v, std::vector<int>{2, 0, 1});
+    EXPECT_EQ(v[0], (std::tuple<int, std::string>{3, "three"}));
+    EXPECT_EQ(v[1], (std::tuple<int, std::string>{1, "one"}));
+    EXPECT_EQ(v[2], (std::tuple<int, std::string>{2, "two"}));
+}
+
+TEST(ForEach, EveryRowInOrder) {
+    // Whatever the misalignment of the columns and the length of the
+    // sequence, prologue, main body and epilogue cover every row once.
+    std::vector<int> x(200);
+    std::vector<short> y(200);
+    std::iota(x.begin(), x.end(), 0);
+    for (std::ptrdiff_t shift = 0; shift < 16; ++shift) {
+        for (std::ptrdiff_t size : {0, 1, 15, 16, 17, 40, 100, 150}) {
+            zip::slice<const int*> xs{x.data() + shift, x.data() + shift + size};
+            zip::slice<short*> ys{y.data() + 3, y.data() + 3 + size};
+            std::vector<int> seen;
+            auto f = zip::for_each(zip::zip(xs, ys), [&seen](auto&& row) {
+                auto&& [a, b] = row;
+                b = static_cast<short>(a * 2);
+                seen.push_back(a);
+            });
+            std::vector<int> expected(static_cast<std::size_t>(size));
+            std::iota(expected.begin(), expected.end(), static_cast<int>(shift));
+            EXPECT_EQ(seen, expected);
+            for (std::ptrdiff_t i = 0; i < size; ++i) {
+                EXPECT_EQ(ys[i], xs[i] * 2);
+            }
+            f(std::tuple<int, short&>{0, y[0]});
+            EXPECT_EQ(seen.size(), static_cast<std::size_t>(size) + 1);
+        }
+    }
+}
+
+TEST(ForEach, AlignedColumn) {
+    using written = zip::offset_iterator<const char*, const double*, int*, float*>;
+    using read_only = zip::offset_iterator<const char*, const double*, const int*>;
+    constexpr auto written_column =
+        zip::impl::aligned_column<written>(std::make_index_sequence<4>{});
+    constexpr auto read_only_column =
+        zip::impl::aligned_column<read_only>(std::make_index_sequence<3>{});
+    static_assert(written_column == 2, "the first written column is aligned");
+    static_assert(read_only_column == 1, "read-only rows get their widest column");
+}
+
+TEST(ForEach, NoAlias) {
+    std::vector<double> x(100);
+    std::iota(x.begin(), x.end(), 0.);
+    std::vector<double> y(100, 1.);
+    std::vector<double> out(101, -1.);
+    for (std::ptrdiff_t shift : {0, 1, 3}) {
+        zip::slice<double*> outs{out.data() + shift, out.data() + shift + 97};
+        zip::for_each(zip::zip(zip::no_alias, outs, x, y), [](auto&& row) {
+            auto&& [o, a, b] = row;
+            o = 2. * a + b;
+        });
+        for (std::ptrdiff_t i = 0; i < 97; ++i) {
+            EXPECT_EQ(outs[i], 2. * static_cast<double>(i) + 1.);
+        }
+    }
+    EXPECT_EQ(out.back(), -1.);
+}
+
+TEST(ForEach, NotContiguous) {
+    std::deque<int> x{1, 2, 3, 4, 5};
+    std::vector<int> y(5);
+    zip::for_each(zip::zip(x, y), [](auto&& row) {
+        auto&& [a, b] = row;
+        b = a * a;
+    });
+    EXPECT_THAT(y, testing::ElementsAre(1, 4, 9, 16, 25));
+
+    int sum = 0;
+    zip::for_each(zip::enumerate(x), [&sum](auto&& row) {
+        auto&& [i, a] = row;
+        sum += static_cast<int>(i) * a;
+    });
+    EXPECT_EQ(sum, 40);
+}
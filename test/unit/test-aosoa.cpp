@@ -0,0 +1,121 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zip.h>
+#include <zip/aosoa.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "test-helpers.h"
+
+TEST(Aosoa, Empty) {
+    zip::aosoa<8, int, double> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.size(), 0);
+    EXPECT_EQ(std::begin(v), std::end(v));
+    EXPECT_TRUE(v.tiles().empty());
+}
+
+TEST(Aosoa, PushBack) {
+    zip::aosoa<4, int, double> v;
+    for (int i = 0; i < 10; ++i) {
+        v.push_back({i, i * 0.5});
+    }
+    EXPECT_EQ(v.size(), 10);
+    EXPECT_GE(v.capacity(), 10);
+    EXPECT_EQ(v.tiles().size(), 3);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(v[static_cast<std::size_t>(i)], (std::tuple<int, double>{i, i * 0.5}));
+    }
+    EXPECT_EQ(v.back(), (std::tuple<int, double>{9, 4.5}));
+}
+
+TEST(Aosoa, EmplaceBack) {
+    zip::aosoa<2, int, float> v;
+    auto&& [a, b] = v.emplace_back(1, 2.f);
+    a = 3;
+    EXPECT_EQ(std::get<0>(v[0]), 3);
+    EXPECT_EQ(std::get<1>(v[0]), 2.f);
+    v.emplace_back();
+    EXPECT_EQ(v[1], (std::tuple<int, float>{0, 0.f}));
+}
+
+TEST(Aosoa, TileLayout) {
+    zip::aosoa<8, std::int32_t, double> v(20);
+    auto tiles = v.tiles();
+    ASSERT_EQ(tiles.size(), 3);
+    for (auto&& t : tiles) {
+        EXPECT_TRUE(zip::test::is_aligned(&t));
+    }
+    // Row r lives at lane r % 8 of tile r / 8, column by column
+    auto&& [ids, values] = tiles[1];
+    EXPECT_TRUE((std::is_same_v<std::remove_reference_t<decltype(ids)>,
+                                std::array<std::int32_t, 8>>));
+    std::get<1>(v[13]) = 1.5;
+    EXPECT_EQ(values[5], 1.5);
+    // Lanes past the last row are value-initialised
+    auto&& [tail_ids, tail_values] = tiles[2];
+    EXPECT_EQ(tail_ids, (std::array<std::int32_t, 8>{0, 0, 0, 0, 0, 0, 0, 0}));
+    EXPECT_THAT(tail_values, ::testing::Each(0.));
+}
+
+TEST(Aosoa, TileTraversal) {
+    zip::aosoa<4, float, float> v;
+    for (int i = 0; i < 7; ++i) {
+        v.emplace_back(static_cast<float>(i), 1.f);
+    }
+    for (auto&& [x, y] : v.tiles()) {
+        for (std::size_t i = 0; i < 4; ++i) {
+            y[i] += x[i];
+        }
+    }
+    std::vector<float> ys;
+    for (auto&& [x, y] : v) {
+        ys.push_back(y);
+    }
+    EXPECT_EQ(ys, (std::vector<float>{1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f}));
+}
+
+TEST(Aosoa, ResizeResetsTail) {
+    zip::aosoa<4, int> v(7);
+    std::fill(std::begin(v), std::end(v), std::tuple<int>{5});
+    v.resize(5);
+    v.pop_back();
+    EXPECT_EQ(v.size(), 4);
+    EXPECT_EQ(v.tiles().size(), 1);
+    v.resize(8);
+    auto&& [tail] = v.tiles()[1];
+    EXPECT_EQ(tail, (std::array<int, 4>{0, 0, 0, 0}));
+}
+
+TEST(Aosoa, OffsetIterator) {
+    zip::aosoa<8, int, long> v(100);
+    EXPECT_TRUE(zip::is_offset_iterator_v<decltype(std::begin(v))>);
+    EXPECT_EQ(std::end(v) - std::begin(v), 100);
+
+    for (std::size_t i = 0; i < 100; ++i) {
+        v[i] = std::tuple<int, long>{static_cast<int>(99 - i), static_cast<long>(i)};
+    }
+    std::sort(std::begin(v), std::end(v));
+    for (std::size_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(v[i], (std::tuple<int, long>{static_cast<int>(i), static_cast<long>(99 - i)}));
+    }
+}
+
+TEST(Aosoa, CopyAndSwap) {
+    zip::aosoa<4, int, int> a{{1, 2}, {3, 4}, {5, 6}};
+    auto b = a;
+    std::get<0>(b[0]) = 10;
+    EXPECT_EQ(std::get<0>(a[0]), 1);
+
+    zip::aosoa<4, int, int> c;
+    swap(b, c);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(c.size(), 3);
+    EXPECT_EQ(c[0], (std::tuple<int, int>{10, 2}));
+}
@@ -0,0 +1,142 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+#include <zip.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <execution>
+#include <functional>
+#include <list>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "test-helpers.h"
+
+namespace {
+
+// Parallel algorithms run in an arena of 4 threads, whatever the
+// number of cores of the machine running the tests.
+template <typename Function>
+void run_on_4_threads(Function&& f) {
+    tbb::global_control threads{tbb::global_control::max_allowed_parallelism, 4};
+    tbb::task_arena arena{4};
+    arena.execute(std::forward<Function>(f));
+}
+
+}  // namespace
+
+TEST(Execution, ForEachParUnseq) {
+    std::vector<float> a(10000);
+    std::iota(a.begin(), a.end(), 0.f);
+    std::vector<float> b(10000, 2.f);
+    std::vector<float> out(10000);
+    auto z = zip::zip(a, b, out);
+    std::for_each(std::execution::par_unseq, z.begin(), z.end(), [](auto&& row) {
+        auto&& [x, y, o] = row;
+        o = x * y;
+    });
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        EXPECT_EQ(out[i], 2.f * static_cast<float>(i));
+    }
+}
+
+TEST(Execution, ParallelPathOffset) {
+    std::vector<std::size_t> a(1 << 16);
+    std::iota(a.begin(), a.end(), std::size_t{0});
+    std::vector<std::size_t> b(a.size());
+    zip::test::thread_tracker tracker;
+    run_on_4_threads([&] {
+        auto z = zip::zip(a, b);
+        std::for_each(std::execution::par, z.begin(), z.end(), [&](auto&& row) {
+            auto&& [i, o] = row;
+            tracker.visit(i);
+            o = i + 1;
+        });
+    });
+    EXPECT_GT(tracker.threads(), 1);
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        EXPECT_EQ(b[i], i + 1);
+    }
+}
+
+TEST(Execution, ParallelPathLockstep) {
+    std::deque<std::size_t> a(1 << 16);
+    std::iota(a.begin(), a.end(), std::size_t{0});
+    std::vector<std::size_t> b(a.size());
+    zip::test::thread_tracker tracker;
+    run_on_4_threads([&] {
+        auto z = zip::zip(a, b);
+        std::for_each(std::execution::par, z.begin(), z.end(), [&](auto&& row) {
+            auto&& [i, o] = row;
+            tracker.visit(i);
+            o = 2 * i;
+        });
+    });
+    EXPECT_GT(tracker.threads(), 1);
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        EXPECT_EQ(b[i], 2 * i);
+    }
+}
+
+TEST(Execution, TransformReduce) {
+    std::vector<double> x(100000);
+    std::iota(x.begin(), x.end(), 1.);
+    std::vector<double> w(x.size(), .5);
+    auto z = zip::zip(x, w);
+    const auto sum = std::transform_reduce(
+        std::execution::par_unseq, z.begin(), z.end(), 0., std::plus{}, [](auto&& row) {
+            auto&& [v, weight] = row;
+            return v * weight;
+        });
+    EXPECT_DOUBLE_EQ(sum, .5 * 100000. * 100001. / 2.);
+}
+
+TEST(Execution, Sort) {
+    std::vector<int> keys(5000);
+    std::vector<std::string> values;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<int>((i * 7919) % keys.size());
+        values.push_back(std::to_string(keys[i] * 10));
+    }
+    auto z = zip::zip(keys, values);
+    std::sort(std::execution::par_unseq, z.begin(), z.end(),
+              [](auto&& lhs, auto&& rhs) { return std::get<0>(lhs) < std::get<0>(rhs); });
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(keys[i], static_cast<int>(i));
+        EXPECT_EQ(values[i], std::to_string(keys[i] * 10));
+    }
+}
+
+TEST(Execution, CopyIf) {
+    std::vector<int> a(1000);
+    std::iota(a.begin(), a.end(), 0);
+    std::vector<double> b(a.begin(), a.end());
+    std::vector<int> c(a.size());
+    std::vector<double> d(a.size());
+    auto in = zip::zip(a, b);
+    auto out = zip::zip(c, d);
+    auto last = std::copy_if(std::execution::par, in.begin(), in.end(), out.begin(),
+                             [](auto&& row) { return std::get<0>(row) % 3 == 0; });
+    EXPECT_EQ(last - out.begin(), 334);
+    for (std::ptrdiff_t i = 0; i < last - out.begin(); ++i) {
+        EXPECT_EQ(c[static_cast<std::size_t>(i)], 3 * i);
+        EXPECT_EQ(d[static_cast<std::size_t>(i)], static_cast<double>(3 * i));
+    }
+}
+
+TEST(Execution, ForwardFallback) {
+    // Iterators other than random access ones run serially.
+    std::list<int> a{1, 2, 3};
+    std::vector<int> b(3);
+    auto z = zip::zip(a, b);
+    std::for_each(std::execution::par_unseq, z.begin(), z.end(), [](auto&& row) {
+        auto&& [x, o] = row;
+        o = -x;
+    });
+    EXPECT_THAT(b, testing::ElementsAre(-1, -2, -3));
+}
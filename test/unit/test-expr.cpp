@@ -0,0 +1,96 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zip.h>
+#include <zip/expr.h>
+#include <zip/numeric.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+TEST(Expr, Assign) {
+    std::vector<int> x{1, 2, 3, 4};
+    std::vector<int> y{5, 6, 7, 8};
+    std::vector<int> z{-10, -20, -30, -40};
+    std::vector<int> out(4);
+    zip::assign(out, zip::expr(x, y, z)([](int a, int b, int c) { return a * b + c; }));
+    EXPECT_THAT(out, testing::ElementsAre(-5, -8, -9, -8));
+}
+
+TEST(Expr, Chain) {
+    std::vector<float> x{1, 2, 3};
+    std::vector<float> y{4, 5, 6};
+    std::vector<double> out(3);
+    auto e = zip::expr(x, y)([](float a, float b) { return a - b; })([](float v) {
+        return v * v;
+    })([](float v) { return static_cast<double>(v) / 2; });
+    static_assert(std::is_same_v<decltype(e)::value_type, double>,
+                  "stages are composed");
+    zip::assign(out, e);
+    EXPECT_THAT(out, testing::ElementsAre(4.5, 4.5, 4.5));
+}
+
+TEST(Expr, Lazy) {
+    std::vector<int> x{1, 2, 3};
+    int calls = 0;
+    auto e = zip::expr(x)([&calls](int v) {
+        ++calls;
+        return v + 1;
+    });
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(e[2], 4);
+    EXPECT_EQ(calls, 1);
+    // Assigning back into a column read by the expression is fine:
+    // each row is only read before being written.
+    zip::assign(x, e);
+    EXPECT_EQ(calls, 4);
+    EXPECT_THAT(x, testing::ElementsAre(2, 3, 4));
+}
+
+TEST(Expr, ZippedOutput) {
+    std::vector<int> x{1, 2, 3};
+    std::vector<int> sum(3);
+    std::vector<int> product(3);
+    zip::assign(zip::zip(sum, product), zip::expr(x, x)([](int a, int b) {
+                    return std::tuple{a + b, a * b};
+                }));
+    EXPECT_THAT(sum, testing::ElementsAre(2, 4, 6));
+    EXPECT_THAT(product, testing::ElementsAre(1, 4, 9));
+}
+
+TEST(Expr, NoAliasOutput) {
+    std::vector<int> x{4, 1, 3};
+    std::vector<int> y{2, 5, 3};
+    std::vector<int> lo(3);
+    std::vector<int> hi(3);
+    zip::assign(zip::zip(zip::no_alias, lo, hi), zip::expr(x, y)([](int a, int b) {
+                    return std::tuple{a < b ? a : b, a < b ? b : a};
+                }));
+    EXPECT_THAT(lo, testing::ElementsAre(2, 1, 3));
+    EXPECT_THAT(hi, testing::ElementsAre(4, 5, 3));
+}
+
+TEST(Expr, ShortestSequence) {
+    std::vector<int> x{1, 2, 3, 4, 5};
+    std::vector<int> y{1, 1, 1};
+    std::vector<int> out(4, -1);
+    auto e = zip::expr(x, y)([](int a, int b) { return a + b; });
+    EXPECT_EQ(e.size(), 3);
+    zip::assign(out, e);
+    EXPECT_THAT(out, testing::ElementsAre(2, 3, 4, -1));
+}
+
+TEST(Expr, RandomAccessSequence) {
+    std::vector<int> x{3, 1, 2};
+    auto e = zip::expr(x)([](int v) { return v * 10; });
+    static_assert(
+        std::is_same_v<std::iterator_traits<decltype(e.begin())>::iterator_category,
+                       std::random_access_iterator_tag>,
+        "expressions are random access sequences");
+    EXPECT_EQ(e.end() - e.begin(), 3);
+    EXPECT_EQ(*std::max_element(e.begin(), e.end()), 30);
+    EXPECT_EQ(zip::reduce(e, 0), 60);
+}
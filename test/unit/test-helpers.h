@@ -9,8 +9,15 @@
 #include <type_traits>
 #include <forward_list>
 #include <list>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <set>
+#include <thread>
 
 #include <zip.h>
+#include <zip/soa_vector.h>
 #include <gtest/gtest.h>
 
 // Googletest templated test suites
@@ -114,6 +121,48 @@ auto size(ContainerTuple&& data) {
     return std::size(std::get<0>(std::forward<ContainerTuple>(data)));
 }
 
+//
+// Helper: is_aligned(const T*)
+//
+
+// Whether ptr is aligned the way soa_vector, aosoa and mapped_table
+// align their columns.
+template <typename T>
+bool is_aligned(const T* ptr) {
+    return reinterpret_cast<std::uintptr_t>(ptr) % soa_alignment == 0;
+}
+
+//
+// Helper: thread_tracker
+//
+
+// Records the threads running a parallel algorithm. The first row
+// holds its thread until another one shows up (or a few seconds have
+// passed): the parallel path is taken if and only if the rest of the
+// rows get picked up meanwhile.
+class thread_tracker {
+   public:
+    void visit(std::size_t row) {
+        std::unique_lock<std::mutex> lock{m_lock};
+        m_threads.insert(std::this_thread::get_id());
+        m_joined.notify_all();
+        if (row == 0) {
+            m_joined.wait_for(lock, std::chrono::seconds{10},
+                              [this] { return m_threads.size() > 1; });
+        }
+    }
+
+    std::size_t threads() const {
+        std::lock_guard<std::mutex> lock{m_lock};
+        return m_threads.size();
+    }
+
+   private:
+    mutable std::mutex m_lock;
+    std::condition_variable m_joined;
+    std::set<std::thread::id> m_threads;
+};
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zip.h>
+#include <zip/algorithm.h>
+#include <zip/expr.h>
+#include <zip/isa.h>
+#include <zip/numeric.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+constexpr zip::isa all_isas[] = {zip::isa::generic, zip::isa::sse4_2, zip::isa::avx2,
+                                 zip::isa::avx512};
+
+// Sets the active instruction set for the lifetime of a scope.
+class scoped_isa {
+   public:
+    explicit scoped_isa(zip::isa target) : m_previous{zip::set_active_isa(target)} {}
+    ~scoped_isa() { zip::set_active_isa(m_previous); }
+
+   private:
+    zip::isa m_previous;
+};
+
+// The results of the dispatched algorithms over the same input.
+struct results {
+    float sum;
+    std::vector<float> fused;
+    std::vector<std::int32_t> selected;
+    std::vector<float> gathered;
+    std::vector<std::int32_t> doubled;
+};
+
+results run_algorithms() {
+    constexpr std::size_t size = 10007;
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<float> real{-1e3f, 1e3f};
+    std::vector<float> x(size);
+    std::vector<std::int32_t> id(size);
+    std::vector<std::int32_t> order(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        x[i] = real(rng);
+        id[i] = static_cast<std::int32_t>(i);
+        order[i] = static_cast<std::int32_t>((i * 7919) % size);
+    }
+
+    results r;
+    r.sum = zip::reduce(x, 0.f);
+    r.fused.resize(size);
+    zip::assign(r.fused, zip::expr(x, x)([](float a, float b) { return a * b + 1.f; }));
+    r.selected.resize(size);
+    std::vector<float> kept(size);
+    r.selected.resize(zip::filter_copy(
+        zip::zip(id, x), [](auto&& row) { return std::get<1>(row) > 0.f; },
+        zip::zip(r.selected, kept)));
+    r.gathered.resize(size);
+    zip::gather(zip::zip(x), order, zip::zip(r.gathered));
+    r.doubled.resize(size);
+    zip::for_each(zip::zip(id, r.doubled), [](auto&& row) {
+        auto&& [i, d] = row;
+        d = 2 * i;
+    });
+    return r;
+}
+
+}  // namespace
+
+TEST(Isa, Names) {
+    EXPECT_STREQ(zip::isa_name(zip::isa::generic), "generic");
+    EXPECT_STREQ(zip::isa_name(zip::isa::sse4_2), "sse4.2");
+    EXPECT_STREQ(zip::isa_name(zip::isa::avx2), "avx2");
+    EXPECT_STREQ(zip::isa_name(zip::isa::avx512), "avx512");
+}
+
+TEST(Isa, Override) {
+    using zip::impl::parse_isa;
+    EXPECT_EQ(parse_isa(nullptr, zip::isa::avx2), zip::isa::avx2);
+    EXPECT_EQ(parse_isa("sse4.2", zip::isa::avx512), zip::isa::sse4_2);
+    EXPECT_EQ(parse_isa("generic", zip::isa::avx2), zip::isa::generic);
+    // Instruction sets the CPU does not run are never picked.
+    EXPECT_EQ(parse_isa("avx512", zip::isa::avx2), zip::isa::avx2);
+    EXPECT_EQ(parse_isa("neon", zip::isa::sse4_2), zip::isa::sse4_2);
+}
+
+TEST(Isa, SetActive) {
+    const auto supported = zip::supported_isa();
+    EXPECT_LE(zip::active_isa(), supported);
+    {
+        scoped_isa generic{zip::isa::generic};
+        EXPECT_EQ(zip::active_isa(), zip::isa::generic);
+        scoped_isa widest{zip::isa::avx512};
+        EXPECT_EQ(zip::active_isa(), supported);
+    }
+    EXPECT_LE(zip::active_isa(), supported);
+}
+
+TEST(Isa, ClonesAgree) {
+    // Every clone computes exactly the same results, down to the
+    // rounding of the reduction.
+    results expected;
+    {
+        scoped_isa generic{zip::isa::generic};
+        expected = run_algorithms();
+    }
+    for (auto target : all_isas) {
+        if (target > zip::supported_isa()) {
+            continue;
+        }
+        scoped_isa active{target};
+        const auto r = run_algorithms();
+        SCOPED_TRACE(zip::isa_name(target));
+        EXPECT_EQ(r.sum, expected.sum);
+        EXPECT_EQ(r.fused, expected.fused);
+        EXPECT_EQ(r.selected, expected.selected);
+        EXPECT_EQ(r.gathered, expected.gathered);
+        EXPECT_EQ(r.doubled, expected.doubled);
+    }
+}
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <forward_list>
 #include <iterator>
 #include <limits>
@@ -22,6 +23,21 @@ using zip::test::containers;
 using zip::test::end;
 using zip::test::size;
 
+namespace {
+
+// containers() hold x = i, y = 9 - i and z = -i: once permuted, every
+// zipped element must still satisfy the same relation.
+template <typename IteratorCategory, typename ContainerTuple>
+void expect_rows_preserved(IteratorCategory tag, ContainerTuple& data) {
+    std::for_each(begin(tag, data), end(tag, data), [](auto&& e) {
+        auto&& [x, y, z] = e;
+        EXPECT_EQ(static_cast<long long>(y), 9 - static_cast<long long>(x));
+        EXPECT_EQ(static_cast<long long>(z), -static_cast<long long>(x));
+    });
+}
+
+}  // namespace
+
 TEST(MakeIterator, IteratorCategoryRandomAccess) {
     std::array<int, 10> a;
     std::vector<long long> b;
@@ -88,9 +104,9 @@ TEST(MakeIterator, ConstnessPreservedMut) {
 // https://en.cppreference.com/w/cpp/named_req/ForwardIterator
 ///////////////////////////////////////////////////////////
 
-TYPED_TEST_P(ForwardInterface, IsNotDefaultConstructible) {
+TYPED_TEST_P(ForwardInterface, IsDefaultConstructible) {
     using iterator_type = decltype(begin(TypeParam{}, containers(TypeParam{})));
-    EXPECT_FALSE(std::is_default_constructible_v<iterator_type>);
+    EXPECT_TRUE(std::is_default_constructible_v<iterator_type>);
 }
 
 TYPED_TEST_P(ForwardInterface, IsCopyConstructible) {
@@ -323,9 +339,31 @@ TYPED_TEST_P(ForwardInterface, StdForEachStructuredBinding) {
     ASSERT_THAT(z, Each(z_sentinel));
 }
 
+TYPED_TEST_P(ForwardInterface, IterSwap) {
+    auto tag = TypeParam{};
+    auto data = containers(tag);
+    auto& [x, y, z] = data;
+    std::iter_swap(begin(tag, data), std::next(begin(tag, data), 9));
+    EXPECT_EQ(x.front(), 9);
+    EXPECT_EQ(y.front(), 0);
+    EXPECT_EQ(z.front(), -9);
+    expect_rows_preserved(tag, data);
+}
+
+TYPED_TEST_P(ForwardInterface, StdRotate) {
+    auto tag = TypeParam{};
+    auto data = containers(tag);
+    auto& x = std::get<0>(data);
+    auto first = begin(tag, data);
+    auto ret = std::rotate(first, std::next(first, 3), end(tag, data));
+    EXPECT_EQ(ret, std::next(begin(tag, data), 7));
+    EXPECT_EQ(x, (std::vector<std::int32_t>{3, 4, 5, 6, 7, 8, 9, 0, 1, 2}));
+    expect_rows_preserved(tag, data);
+}
+
 // clang-format off
 REGISTER_TYPED_TEST_SUITE_P(ForwardInterface,
-    IsNotDefaultConstructible,
+    IsDefaultConstructible,
     IsCopyConstructible,
     IsCopyAssignable,
     IsMoveConstructible,
@@ -342,7 +380,9 @@ REGISTER_TYPED_TEST_SUITE_P(ForwardInterface,
     ModifyStructuredBinding,
     ModifyRefStructuredBinding,
     StdForEach,
-    StdForEachStructuredBinding);
+    StdForEachStructuredBinding,
+    IterSwap,
+    StdRotate);
 // clang-format on
 
 ///////////////////////////////////////////////////////////
@@ -377,10 +417,32 @@ TYPED_TEST_P(BidirectionalInterface, OperatorDecrementPostfix) {
     EXPECT_EQ(z_item, *(--std::end(std::get<2>(data))));
 }
 
+TYPED_TEST_P(BidirectionalInterface, StdReverse) {
+    auto tag = TypeParam{};
+    auto data = containers(tag);
+    auto& x = std::get<0>(data);
+    std::reverse(begin(tag, data), end(tag, data));
+    EXPECT_EQ(x, (std::vector<std::int32_t>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+    expect_rows_preserved(tag, data);
+}
+
+TYPED_TEST_P(BidirectionalInterface, StdStablePartition) {
+    auto tag = TypeParam{};
+    auto data = containers(tag);
+    auto& x = std::get<0>(data);
+    auto ret = std::stable_partition(begin(tag, data), end(tag, data),
+                                     [](auto&& e) { return std::get<0>(e) % 2 == 0; });
+    EXPECT_EQ(ret, std::next(begin(tag, data), 5));
+    EXPECT_EQ(x, (std::vector<std::int32_t>{0, 2, 4, 6, 8, 1, 3, 5, 7, 9}));
+    expect_rows_preserved(tag, data);
+}
+
 // clang-format off
 REGISTER_TYPED_TEST_SUITE_P(BidirectionalInterface,
     OperatorDecrementPrefix,
-    OperatorDecrementPostfix);
+    OperatorDecrementPostfix,
+    StdReverse,
+    StdStablePartition);
 // clang-format on
 
 ///////////////////////////////////////////////////////////
@@ -496,6 +558,36 @@ TYPED_TEST_P(RandomAccessInterface, StdDistance) {
     EXPECT_EQ(std::distance(it_begin, it_end), size(data));
 }
 
+TYPED_TEST_P(RandomAccessInterface, StdSort) {
+    auto tag = TypeParam{};
+    auto data = containers(tag);
+    auto& x = std::get<0>(data);
+    // Sort by y, i.e. reverse x
+    std::sort(begin(tag, data), end(tag, data),
+              [](auto&& lhs, auto&& rhs) { return std::get<1>(lhs) < std::get<1>(rhs); });
+    EXPECT_EQ(x, (std::vector<std::int32_t>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+    expect_rows_preserved(tag, data);
+    // Default lexicographic ordering of the zipped elements
+    std::sort(begin(tag, data), end(tag, data));
+    EXPECT_EQ(x, (std::vector<std::int32_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_TRUE(std::is_sorted(begin(tag, data), end(tag, data)));
+    expect_rows_preserved(tag, data);
+}
+
+TYPED_TEST_P(RandomAccessInterface, StdNthElement) {
+    auto tag = TypeParam{};
+    auto data = containers(tag);
+    auto& [x, y, z] = data;
+    auto nth = begin(tag, data) + 3;
+    std::nth_element(
+        begin(tag, data), nth, end(tag, data),
+        [](auto&& lhs, auto&& rhs) { return std::get<2>(lhs) < std::get<2>(rhs); });
+    EXPECT_EQ(x[3], 6);
+    EXPECT_EQ(y[3], 3);
+    EXPECT_EQ(z[3], -6);
+    expect_rows_preserved(tag, data);
+}
+
 // clang-format off
 REGISTER_TYPED_TEST_SUITE_P(RandomAccessInterface,
     OperatorMinusIterator,
@@ -508,16 +600,15 @@ REGISTER_TYPED_TEST_SUITE_P(RandomAccessInterface,
     OperatorLE,
     OperatorGT,
     OperatorGE,
-    StdDistance);
+    StdDistance,
+    StdSort,
+    StdNthElement);
 // clang-format on
 
 // TODO
 
 // TYPED_TEST_P(ZipIteratorTest, StdTransform) {}
 // TYPED_TEST_P(ZipIteratorTest, StdFind) {}
-// TYPED_TEST_P(ZipIteratorTest, StdIsSorted) {}
-// TYPED_TEST_P(ZipIteratorTest, StdSort) {}
-// TYPED_TEST_P(ZipIteratorTest, StdNthElement) {}
 
 // clang-format off
 using ForwardCategoryTypes =
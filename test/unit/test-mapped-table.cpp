@@ -0,0 +1,170 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zip.h>
+#include <zip/mapped_table.h>
+#include <zip/soa_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "test-helpers.h"
+
+namespace {
+
+// A file in the test temporary directory, removed on destruction.
+class temp_file {
+   public:
+    temp_file()
+        : m_path{testing::TempDir() + "zip-" +
+                 testing::UnitTest::GetInstance()->current_test_info()->name() +
+                 ".table"} {}
+
+    ~temp_file() { std::remove(m_path.c_str()); }
+
+    const std::string& path() const noexcept { return m_path; }
+
+   private:
+    std::string m_path;
+};
+
+}  // namespace
+
+TEST(MappedTable, RoundTrip) {
+    temp_file file;
+    std::vector<int> a(1000);
+    std::vector<double> b(1000);
+    std::vector<std::uint8_t> c(1000);
+    std::iota(a.begin(), a.end(), 0);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        b[i] = static_cast<double>(i) * 0.5;
+        c[i] = static_cast<std::uint8_t>(i);
+    }
+    zip::write_table(file.path(), zip::zip(a, b, c));
+
+    zip::mapped_table<int, double, std::uint8_t> table{file.path()};
+    ASSERT_EQ(table.size(), 1000);
+    EXPECT_TRUE(zip::test::is_aligned(table.column<0>().data()));
+    EXPECT_TRUE(zip::test::is_aligned(table.column<1>().data()));
+    EXPECT_TRUE(zip::test::is_aligned(table.column<2>().data()));
+    EXPECT_THAT(table.column<0>(), testing::ElementsAreArray(a));
+    EXPECT_THAT(table.column<1>(), testing::ElementsAreArray(b));
+    EXPECT_THAT(table.column<2>(), testing::ElementsAreArray(c));
+
+    std::size_t i = 0;
+    for (auto&& [x, y, z] : table.view()) {
+        EXPECT_EQ(x, a[i]);
+        EXPECT_EQ(y, b[i]);
+        EXPECT_EQ(z, c[i]);
+        ++i;
+    }
+    EXPECT_EQ(i, 1000);
+}
+
+TEST(MappedTable, ViewIsOffset) {
+    temp_file file;
+    zip::soa_vector<int, float> v{{1, 1.5f}, {2, 2.5f}};
+    zip::write_table(file.path(), v);
+
+    zip::mapped_table<int, float> table{file.path()};
+    auto view = table.view();
+    static_assert(zip::is_offset_iterator_v<decltype(std::begin(view))>,
+                  "mapped tables are contiguous");
+    EXPECT_EQ(std::end(view) - std::begin(view), 2);
+    EXPECT_EQ(std::begin(view)[1], (std::tuple<int, float>{2, 2.5f}));
+}
+
+TEST(MappedTable, NonContiguousSource) {
+    struct row {
+        short a;
+        long b;
+    };
+    temp_file file;
+    std::vector<row> rows{{3, 9}, {1, 2}, {4, 6}, {1, 5}, {5, 3}};
+    zip::write_table(file.path(), zip::fields(rows, &row::a, &row::b));
+
+    zip::mapped_table<short, long> table{file.path()};
+    EXPECT_THAT(table.column<0>(), testing::ElementsAre(3, 1, 4, 1, 5));
+    EXPECT_THAT(table.column<1>(), testing::ElementsAre(9, 2, 6, 5, 3));
+}
+
+TEST(MappedTable, Empty) {
+    temp_file file;
+    std::vector<int> a;
+    std::vector<float> b;
+    zip::write_table(file.path(), zip::zip(a, b));
+
+    zip::mapped_table<int, float> table{file.path()};
+    EXPECT_TRUE(table.empty());
+    auto view = table.view();
+    EXPECT_EQ(std::begin(view), std::end(view));
+}
+
+TEST(MappedTable, Move) {
+    temp_file file;
+    std::vector<int> a{1, 2, 3};
+    zip::write_table(file.path(), zip::zip(a));
+
+    zip::mapped_table<int> table{file.path()};
+    zip::mapped_table<int> moved{std::move(table)};
+    EXPECT_TRUE(table.empty());
+    EXPECT_THAT(moved.column<0>(), testing::ElementsAre(1, 2, 3));
+
+    // The file can go away: the mapping keeps its pages alive.
+    std::remove(file.path().c_str());
+    EXPECT_THAT(moved.column<0>(), testing::ElementsAre(1, 2, 3));
+}
+
+TEST(MappedTable, TypeMismatch) {
+    temp_file file;
+    std::vector<int> a{1, 2, 3};
+    std::vector<float> b{1, 2, 3};
+    zip::write_table(file.path(), zip::zip(a, b));
+
+    using table_int_int = zip::mapped_table<int, int>;
+    using table_int_unsigned = zip::mapped_table<int, unsigned>;
+    using table_int = zip::mapped_table<int>;
+    using table_int_double = zip::mapped_table<int, double>;
+    EXPECT_THROW(table_int_int{file.path()}, std::runtime_error);
+    EXPECT_THROW(table_int_unsigned{file.path()}, std::runtime_error);
+    EXPECT_THROW(table_int{file.path()}, std::runtime_error);
+    EXPECT_THROW(table_int_double{file.path()}, std::runtime_error);
+}
+
+TEST(MappedTable, MissingFile) {
+    temp_file file;
+    EXPECT_THROW(zip::mapped_table<int>{file.path()}, std::system_error);
+}
+
+TEST(MappedTable, NotATable) {
+    temp_file file;
+    {
+        std::ofstream out{file.path()};
+        out << "definitely not a table, but long enough for a header";
+    }
+    EXPECT_THROW(zip::mapped_table<int>{file.path()}, std::runtime_error);
+}
+
+TEST(MappedTable, Truncated) {
+    temp_file file;
+    std::vector<double> a(100, 1.0);
+    zip::write_table(file.path(), zip::zip(a));
+    std::vector<char> bytes;
+    {
+        std::ifstream in{file.path(), std::ios::binary};
+        bytes.assign(std::istreambuf_iterator<char>{in}, {});
+    }
+    {
+        std::ofstream out{file.path(), std::ios::binary | std::ios::trunc};
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2));
+    }
+    EXPECT_THROW(zip::mapped_table<double>{file.path()}, std::runtime_error);
+}
@@ -0,0 +1,96 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zip.h>
+#include <zip/numeric.h>
+#include <zip/parallel.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<float> random_floats(std::size_t size, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::uniform_real_distribution<float> dist{-1e3f, 1e3f};
+    std::vector<float> ret(size);
+    for (auto&& x : ret) {
+        x = dist(gen);
+    }
+    return ret;
+}
+
+bool bitwise_equal(float lhs, float rhs) {
+    return std::memcmp(&lhs, &rhs, sizeof(float)) == 0;
+}
+
+}  // namespace
+
+TEST(Reduce, Empty) {
+    std::vector<int> a;
+    EXPECT_EQ(zip::reduce(a, 42), 42);
+    EXPECT_EQ(zip::transform_reduce(zip::zip(a, a), 42, std::plus<>{},
+                                    [](auto&&) { return 1; }),
+              42);
+}
+
+TEST(Reduce, Integers) {
+    for (std::size_t size : {1u, 7u, 8u, 9u, 100u, 4096u, 4097u, 100000u}) {
+        std::vector<std::int64_t> a(size);
+        std::iota(std::begin(a), std::end(a), std::int64_t{-50});
+        EXPECT_EQ(zip::reduce(a, std::int64_t{3}),
+                  std::accumulate(std::begin(a), std::end(a), std::int64_t{3}));
+    }
+}
+
+TEST(Reduce, ReproducibleAcrossThreadCounts) {
+    const auto a = random_floats(1000003, 1);
+    zip::thread_pool serial{0};
+    const auto expected = zip::reduce(serial, a, 0.f, std::plus<>{});
+    for (std::size_t workers : {1u, 2u, 5u}) {
+        zip::thread_pool pool{workers};
+        for (int run = 0; run < 3; ++run) {
+            const auto actual = zip::reduce(pool, a, 0.f, std::plus<>{});
+            EXPECT_TRUE(bitwise_equal(actual, expected));
+        }
+    }
+    EXPECT_NEAR(expected, std::accumulate(std::begin(a), std::end(a), 0.0), 1.0);
+}
+
+TEST(TransformReduce, Zip) {
+    const auto a = random_floats(50000, 2);
+    const auto b = random_floats(50000, 3);
+    const auto dot = [](auto&& e) {
+        auto&& [x, y] = e;
+        return x * y;
+    };
+    zip::thread_pool serial{0};
+    zip::thread_pool pool{3};
+    const auto expected =
+        zip::transform_reduce(serial, zip::zip(a, b), 0.f, std::plus<>{}, dot);
+    EXPECT_TRUE(bitwise_equal(
+        zip::transform_reduce(pool, zip::zip(a, b), 0.f, std::plus<>{}, dot), expected));
+    EXPECT_NEAR(expected,
+                std::inner_product(std::begin(a), std::end(a), std::begin(b), 0.0),
+                std::abs(expected) * 1e-3);
+}
+
+TEST(TransformReduce, FixedTree) {
+    // 10 elements: 8 lanes, the last 2 ones folded into lanes 0 and 1,
+    // then ((l0 + l1) + (l2 + l3)) + ((l4 + l5) + (l6 + l7))
+    std::vector<int> a{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<int> order;
+    const auto trace = [&order](int lhs, int rhs) {
+        order.push_back(lhs);
+        order.push_back(rhs);
+        return lhs + rhs;
+    };
+    zip::thread_pool serial{0};
+    EXPECT_EQ(zip::reduce(serial, a, 100, trace), 145);
+    EXPECT_EQ(order, (std::vector<int>{0, 8, 1, 9, 8, 10, 2, 3, 4, 5, 6, 7, 18, 5, 9,
+                                       13, 23, 22, 100, 45}));
+}
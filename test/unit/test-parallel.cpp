@@ -0,0 +1,151 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zip.h>
+#include <zip/parallel.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "test-helpers.h"
+
+// Matchers
+using ::testing::Each;
+
+TEST(ThreadPool, RunsEveryTaskOnce) {
+    zip::thread_pool pool{3};
+    std::vector<std::atomic<int>> hits(1000);
+    pool.run(std::size(hits), [&](std::size_t i) { ++hits[i]; });
+    for (auto&& h : hits) {
+        EXPECT_EQ(h.load(), 1);
+    }
+}
+
+TEST(ThreadPool, NoWorkers) {
+    zip::thread_pool pool{0};
+    EXPECT_EQ(pool.concurrency(), 1);
+    std::vector<int> hits(10);
+    pool.run(std::size(hits), [&](std::size_t i) { ++hits[i]; });
+    ASSERT_THAT(hits, Each(1));
+}
+
+TEST(ThreadPool, Reusable) {
+    zip::thread_pool pool{2};
+    std::atomic<std::size_t> count{0};
+    for (int job = 0; job < 100; ++job) {
+        pool.run(17, [&](std::size_t) { ++count; });
+    }
+    EXPECT_EQ(count.load(), 1700);
+}
+
+TEST(ThreadPool, NestedRunIsInline) {
+    zip::thread_pool pool{2};
+    std::atomic<std::size_t> count{0};
+    pool.run(8, [&](std::size_t) { pool.run(8, [&](std::size_t) { ++count; }); });
+    EXPECT_EQ(count.load(), 64);
+}
+
+TEST(ThreadPool, RethrowsTaskException) {
+    zip::thread_pool pool{2};
+    EXPECT_THROW(pool.run(64,
+                          [](std::size_t i) {
+                              if (i == 42) {
+                                  throw std::runtime_error{"task failed"};
+                              }
+                          }),
+                 std::runtime_error);
+    // The pool is still usable afterwards
+    std::atomic<std::size_t> count{0};
+    pool.run(64, [&](std::size_t) { ++count; });
+    EXPECT_EQ(count.load(), 64);
+}
+
+TEST(ParallelForEach, Contiguous) {
+    zip::thread_pool pool{3};
+    std::vector<std::int64_t> a(100000);
+    std::vector<double> b(100000);
+    std::iota(std::begin(a), std::end(a), 0);
+    zip::parallel_for_each(pool, zip::zip(a, b), [](auto&& e) {
+        auto&& [x, y] = e;
+        y = static_cast<double>(x) * 2;
+        x = -1;
+    });
+    ASSERT_THAT(a, Each(-1));
+    for (std::size_t i = 0; i < std::size(b); ++i) {
+        EXPECT_EQ(b[i], static_cast<double>(i) * 2);
+    }
+}
+
+TEST(ParallelForEach, RandomAccess) {
+    zip::thread_pool pool{3};
+    std::deque<int> a(50000, 1);
+    std::vector<int> b(50000, 2);
+    zip::parallel_for_each(pool, zip::zip(a, b), [](auto&& e) {
+        auto&& [x, y] = e;
+        x += y;
+    });
+    ASSERT_THAT(a, Each(3));
+}
+
+TEST(ParallelForEach, Offset) {
+    std::vector<int> a(50000, 1);
+    std::vector<int> b(50000, 2);
+    zip::parallel_for_each(zip::zip(zip::offset_iterator_tag{}, a, b), [](auto&& e) {
+        auto&& [x, y] = e;
+        y -= x;
+    });
+    ASSERT_THAT(b, Each(1));
+}
+
+TEST(ParallelForEach, ShortestSequence) {
+    zip::thread_pool pool{3};
+    std::vector<int> a(20000, 0);
+    std::vector<int> b(30000, 0);
+    zip::parallel_for_each(pool, zip::zip(a, b), [](auto&& e) {
+        auto&& [x, y] = e;
+        x = 1;
+        y = 1;
+    });
+    ASSERT_THAT(a, Each(1));
+    EXPECT_EQ(std::accumulate(std::begin(b), std::end(b), 0), 20000);
+}
+
+TEST(ParallelForEach, Empty) {
+    std::vector<int> a;
+    std::vector<int> b;
+    std::size_t calls = 0;
+    zip::parallel_for_each(zip::zip(a, b), [&](auto&&) { ++calls; });
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(ParallelForEach, Chunks) {
+    zip::thread_pool pool{3};
+    std::vector<int> a(100000, 1);
+    std::vector<int> b(100000, 0);
+    zip::parallel_for_each(pool, zip::chunks(zip::zip(a, b), 1000), [](auto&& chunk) {
+        for (auto&& [x, y] : chunk) {
+            x *= 3;
+        }
+        for (auto&& [x, y] : chunk) {
+            y = x + 1;
+        }
+    });
+    ASSERT_THAT(a, Each(3));
+    ASSERT_THAT(b, Each(4));
+}
+
+TEST(ParallelForEach, ChunksRunConcurrently) {
+    // Fewer chunks than rows worth a task: each one is still a task.
+    zip::thread_pool pool{3};
+    std::vector<std::size_t> a(1 << 20);
+    std::iota(std::begin(a), std::end(a), std::size_t{0});
+    zip::test::thread_tracker tracker;
+    zip::parallel_for_each(pool, zip::chunks(zip::zip(a), 1024), [&](auto&& chunk) {
+        tracker.visit(std::get<0>(*std::begin(chunk)));
+    });
+    EXPECT_GT(tracker.threads(), 1);
+}
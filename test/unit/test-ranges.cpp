@@ -0,0 +1,176 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zip.h>
+
+#include <algorithm>
+#include <deque>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+template <typename... Sequences>
+using view_t = decltype(zip::zip(std::declval<Sequences&>()...));
+
+using offset_view = view_t<std::vector<int>, std::vector<std::string>>;
+using lockstep_view = view_t<std::deque<int>, std::vector<std::string>>;
+using bidirectional_view = view_t<std::list<int>, std::vector<std::string>>;
+using forward_view = view_t<std::forward_list<int>, std::vector<std::string>>;
+using enumerate_view = decltype(zip::enumerate(std::declval<std::vector<int>&>()));
+
+template <typename View>
+constexpr bool is_random_access_view_v =
+    std::ranges::view<View> && std::ranges::borrowed_range<View> &&
+    std::ranges::random_access_range<View> && std::ranges::sized_range<View> &&
+    std::ranges::common_range<View> &&
+    std::sortable<std::ranges::iterator_t<View>> &&
+    std::indirectly_swappable<std::ranges::iterator_t<View>> &&
+    std::indirectly_copyable<std::ranges::iterator_t<View>,
+                             std::ranges::iterator_t<View>>;
+
+}  // namespace
+
+TEST(Ranges, Concepts) {
+    static_assert(is_random_access_view_v<offset_view>);
+    static_assert(is_random_access_view_v<lockstep_view>);
+    static_assert(std::random_access_iterator<zip::offset_iterator<int*, long*>>);
+    static_assert(
+        std::random_access_iterator<zip::random_access_iterator<int*, const long*>>);
+
+    static_assert(std::ranges::view<bidirectional_view>);
+    static_assert(std::ranges::bidirectional_range<bidirectional_view>);
+    static_assert(!std::ranges::random_access_range<bidirectional_view>);
+    static_assert(std::ranges::view<forward_view>);
+    static_assert(std::ranges::forward_range<forward_view>);
+    static_assert(!std::ranges::bidirectional_range<forward_view>);
+
+    static_assert(std::ranges::view<enumerate_view>);
+    static_assert(std::ranges::random_access_range<enumerate_view>);
+}
+
+TEST(Ranges, IterMove) {
+    using iterator = std::ranges::iterator_t<offset_view>;
+    static_assert(std::is_same_v<std::iter_rvalue_reference_t<iterator>,
+                                 zip::reference_tuple<int&&, std::string&&>>);
+    static_assert(std::is_same_v<std::iter_value_t<iterator>,
+                                 zip::value_tuple<int, std::string>>);
+    std::vector<int> a{1, 2};
+    std::vector<std::string> b{"one", "two"};
+    auto z = zip::zip(a, b);
+    std::iter_value_t<iterator> row = std::ranges::iter_move(z.begin());
+    EXPECT_EQ(std::get<1>(row), "one");
+    EXPECT_TRUE(b[0].empty());
+    std::ranges::iter_swap(z.begin(), z.begin() + 1);
+    EXPECT_THAT(a, testing::ElementsAre(2, 1));
+    EXPECT_THAT(b, testing::ElementsAre("two", ""));
+}
+
+TEST(Ranges, Sort) {
+    std::vector<int> keys{3, 1, 2, 0};
+    std::vector<std::string> values{"three", "one", "two", "zero"};
+    std::ranges::sort(zip::zip(keys, values), std::ranges::less{},
+                      [](const auto& row) { return std::get<0>(row); });
+    EXPECT_THAT(keys, testing::ElementsAre(0, 1, 2, 3));
+    EXPECT_THAT(values, testing::ElementsAre("zero", "one", "two", "three"));
+
+    // Rows compare as tuples.
+    std::deque<int> major{1, 0, 1, 0};
+    std::vector<int> minor{0, 1, 1, 0};
+    std::ranges::sort(zip::zip(major, minor), std::ranges::greater{});
+    EXPECT_THAT(major, testing::ElementsAre(1, 1, 0, 0));
+    EXPECT_THAT(minor, testing::ElementsAre(1, 0, 1, 0));
+}
+
+TEST(Ranges, MoveOnly) {
+    std::vector<int> keys{3, 1, 2};
+    std::vector<std::unique_ptr<int>> values;
+    for (auto k : keys) {
+        values.push_back(std::make_unique<int>(k * 10));
+    }
+    std::vector<int> other_keys(3);
+    std::vector<std::unique_ptr<int>> other_values(3);
+    // What std::ranges::move is specified to do, element by element.
+    auto in = zip::zip(keys, values);
+    auto out = zip::zip(other_keys, other_values).begin();
+    for (auto it = in.begin(); it != in.end(); ++it, ++out) {
+        *out = std::ranges::iter_move(it);
+    }
+    EXPECT_THAT(other_keys, testing::ElementsAre(3, 1, 2));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], nullptr);
+        ASSERT_NE(other_values[i], nullptr);
+        EXPECT_EQ(*other_values[i], other_keys[i] * 10);
+    }
+}
+
+TEST(Ranges, Copy) {
+    std::vector<int> a{1, 2, 3};
+    std::vector<double> b{.5, 1.5, 2.5};
+    std::vector<int> c(3);
+    std::vector<double> d(3);
+    const auto result = std::ranges::copy(zip::zip(a, b), zip::zip(c, d).begin());
+    EXPECT_EQ(result.in, zip::zip(a, b).end());
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(d, b);
+
+    std::list<int> e(2);
+    std::vector<double> f(2);
+    std::ranges::copy(zip::zip(a, b) | std::views::reverse | std::views::take(2),
+                      zip::zip(e, f).begin());
+    EXPECT_THAT(e, testing::ElementsAre(3, 2));
+    EXPECT_THAT(f, testing::ElementsAre(2.5, 1.5));
+
+    // Sources are left intact, whatever their elements.
+    std::vector<std::string> g{"one", "two", "three"};
+    std::vector<int> h(3);
+    std::vector<std::string> i(3);
+    std::ranges::copy(zip::zip(a, g), zip::zip(h, i).begin());
+    EXPECT_THAT(i, testing::ElementsAre("one", "two", "three"));
+    EXPECT_THAT(g, testing::ElementsAre("one", "two", "three"));
+    std::ranges::copy_if(zip::zip(a, g), zip::zip(h, i).begin(),
+                         [](int x) { return x > 1; },
+                         [](const auto& row) { return std::get<0>(row); });
+    EXPECT_THAT(i, testing::ElementsAre("two", "three", "three"));
+    EXPECT_THAT(g, testing::ElementsAre("one", "two", "three"));
+}
+
+TEST(Ranges, Borrowed) {
+    std::vector<int> a{4, 5, 6};
+    std::vector<char> b{'a', 'b', 'c'};
+    // Views are borrowed: iterators found in a temporary view are
+    // still valid once the view is gone.
+    auto it = std::ranges::find_if(
+        zip::zip(a, b), [](const auto& row) { return std::get<1>(row) == 'b'; });
+    static_assert(!std::is_same_v<decltype(it), std::ranges::dangling>);
+    EXPECT_EQ(std::get<0>(*it), 5);
+}
+
+TEST(Ranges, Adaptors) {
+    std::vector<int> a{1, 2, 3, 4, 5, 6};
+    std::list<int> b{6, 5, 4, 3, 2, 1};
+    std::vector<int> sums;
+    for (auto&& [x, y] : zip::zip(a, b) | std::views::filter([](const auto& row) {
+                             return std::get<0>(row) % 2 == 0;
+                         })) {
+        sums.push_back(x * 10 + y);
+    }
+    EXPECT_THAT(sums, testing::ElementsAre(25, 43, 61));
+
+    const auto view = zip::enumerate(a);
+    EXPECT_EQ(std::ranges::size(view), a.size());
+    EXPECT_EQ(std::ranges::distance(view | std::views::drop(4)), 2);
+    std::vector<std::size_t> odd;
+    for (auto&& [i, x] : view | std::views::filter([](const auto& row) {
+                             return std::get<1>(row) % 2 == 1;
+                         })) {
+        odd.push_back(i);
+    }
+    EXPECT_THAT(odd, testing::ElementsAre(0, 2, 4));
+}
@@ -0,0 +1,159 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zip.h>
+#include <zip/soa_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "test-helpers.h"
+
+namespace {
+
+// Throws on the n-th copy, counting from the creation of the first
+// instance.
+struct throwing_copy {
+    static inline int copies_left = 0;
+    int value = 0;
+
+    throwing_copy(int v) : value{v} {}
+    throwing_copy(const throwing_copy& other) : value{other.value} {
+        if (copies_left-- == 0) {
+            throw std::runtime_error{"copy failed"};
+        }
+    }
+    throwing_copy& operator=(const throwing_copy&) = default;
+};
+
+}  // namespace
+
+TEST(SoaVector, Empty) {
+    zip::soa_vector<int, double> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.size(), 0);
+    EXPECT_EQ(v.capacity(), 0);
+    EXPECT_EQ(std::begin(v), std::end(v));
+}
+
+TEST(SoaVector, PushBack) {
+    zip::soa_vector<int, std::string, char> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back({i, std::to_string(i), static_cast<char>('a' + i % 26)});
+    }
+    ASSERT_EQ(v.size(), 100);
+    EXPECT_GE(v.capacity(), 100);
+    for (int i = 0; i < 100; ++i) {
+        auto&& [n, s, c] = v[static_cast<std::size_t>(i)];
+        EXPECT_EQ(n, i);
+        EXPECT_EQ(s, std::to_string(i));
+        EXPECT_EQ(c, static_cast<char>('a' + i % 26));
+    }
+}
+
+TEST(SoaVector, EmplaceBack) {
+    zip::soa_vector<int, std::unique_ptr<int>> v;
+    auto&& [n, p] = v.emplace_back(42, std::make_unique<int>(7));
+    EXPECT_EQ(n, 42);
+    EXPECT_EQ(*p, 7);
+    v.emplace_back();
+    EXPECT_EQ(std::get<0>(v.back()), 0);
+    EXPECT_EQ(std::get<1>(v.back()), nullptr);
+    // Move-only columns survive reallocations
+    for (int i = 0; i < 50; ++i) {
+        v.emplace_back(i, std::make_unique<int>(i));
+    }
+    EXPECT_EQ(*std::get<1>(v[0]), 7);
+    EXPECT_EQ(*std::get<1>(v[51]), 49);
+}
+
+TEST(SoaVector, EmplaceOwnElementAtCapacity) {
+    zip::soa_vector<std::string, int> v;
+    v.reserve(4);
+    for (int i = 0; i < 4; ++i) {
+        v.emplace_back(std::string(32, static_cast<char>('a' + i)), i);
+    }
+    ASSERT_EQ(v.size(), v.capacity());
+    // The arguments refer to the block that growing releases
+    v.emplace_back(std::get<0>(v[0]), std::get<1>(v[0]));
+    ASSERT_EQ(v.size(), 5);
+    EXPECT_EQ(std::get<0>(v[4]), std::string(32, 'a'));
+    EXPECT_EQ(std::get<1>(v[4]), 0);
+    EXPECT_EQ(std::get<0>(v[0]), std::string(32, 'a'));
+}
+
+TEST(SoaVector, SingleAlignedAllocation) {
+    zip::soa_vector<char, double, std::int16_t> v(3);
+    v.reserve(1000);
+    EXPECT_TRUE(zip::test::is_aligned(v.data<0>()));
+    EXPECT_TRUE(zip::test::is_aligned(v.data<1>()));
+    EXPECT_TRUE(zip::test::is_aligned(v.data<2>()));
+    // All columns live in the same block, laid out one after the other
+    const auto* first = reinterpret_cast<const std::byte*>(v.data<0>());
+    const auto* last = reinterpret_cast<const std::byte*>(v.data<2>());
+    EXPECT_LT(last - first, 1000 * static_cast<std::ptrdiff_t>(
+                                       sizeof(char) + sizeof(double) + sizeof(short) +
+                                       2 * zip::soa_alignment));
+}
+
+TEST(SoaVector, OffsetIterator) {
+    zip::soa_vector<int, long long> v{{1, 10}, {2, 20}, {3, 30}};
+    EXPECT_TRUE((std::is_same_v<decltype(std::begin(v)),
+                                zip::offset_iterator<int*, long long*>>));
+    EXPECT_TRUE((std::is_same_v<decltype(std::begin(std::as_const(v))),
+                                zip::offset_iterator<const int*, const long long*>>));
+    EXPECT_EQ(std::end(v) - std::begin(v), 3);
+    for (auto&& [a, b] : v) {
+        b += a;
+    }
+    EXPECT_EQ(v[0], std::make_tuple(1, 11));
+    EXPECT_EQ(v[1], std::make_tuple(2, 22));
+    EXPECT_EQ(v[2], std::make_tuple(3, 33));
+}
+
+TEST(SoaVector, Resize) {
+    zip::soa_vector<int, float> v(5);
+    EXPECT_EQ(v.size(), 5);
+    EXPECT_EQ(v[4], std::make_tuple(0, 0.0f));
+    v.resize(2);
+    EXPECT_EQ(v.size(), 2);
+    v.pop_back();
+    EXPECT_EQ(v.size(), 1);
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(SoaVector, CopyAndMove) {
+    zip::soa_vector<int, std::string> a{{1, "one"}, {2, "two"}};
+    auto b = a;
+    std::get<1>(b[0]) = "uno";
+    EXPECT_EQ(std::get<1>(a[0]), "one");
+    auto c = std::move(b);
+    EXPECT_EQ(c.size(), 2);
+    EXPECT_EQ(std::get<1>(c[0]), "uno");
+    a = c;
+    EXPECT_EQ(std::get<1>(a[0]), "uno");
+}
+
+TEST(SoaVector, StrongGuaranteeOnGrowth) {
+    zip::soa_vector<std::string, throwing_copy> v;
+    throwing_copy::copies_left = 100;
+    v.reserve(4);
+    for (int i = 0; i < 4; ++i) {
+        v.push_back({std::to_string(i), throwing_copy{i}});
+    }
+    // Growing copies the second column, which fails half way
+    throwing_copy::copies_left = 2;
+    EXPECT_THROW(v.push_back({"4", throwing_copy{4}}), std::runtime_error);
+    ASSERT_EQ(v.size(), 4);
+    EXPECT_EQ(v.capacity(), 4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(std::get<0>(v[static_cast<std::size_t>(i)]), std::to_string(i));
+        EXPECT_EQ(std::get<1>(v[static_cast<std::size_t>(i)]).value, i);
+    }
+}
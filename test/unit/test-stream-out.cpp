@@ -0,0 +1,83 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zip.h>
+#include <zip/expr.h>
+#include <zip/stream_out.h>
+
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <vector>
+
+TEST(StreamOut, SingleColumn) {
+    std::vector<int> x(1000);
+    std::iota(x.begin(), x.end(), 0);
+    std::vector<int> out(1000);
+    zip::assign(zip::stream_out(out), zip::expr(x)([](int v) { return v * 3; }));
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        EXPECT_EQ(out[i], static_cast<int>(i) * 3);
+    }
+}
+
+TEST(StreamOut, ZippedColumns) {
+    std::vector<float> x(777);
+    std::iota(x.begin(), x.end(), 0.f);
+    std::vector<double> sum(777);
+    std::vector<char> parity(777);
+    std::vector<short> same(777);
+    auto out = zip::stream_out(sum, parity, same);
+    EXPECT_EQ(out.size(), 777);
+    zip::assign(out, zip::expr(x)([](float v) {
+                    return std::tuple{v + 0.5, static_cast<char>(static_cast<int>(v) % 2),
+                                      static_cast<short>(v)};
+                }));
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        EXPECT_EQ(sum[i], static_cast<double>(i) + 0.5);
+        EXPECT_EQ(parity[i], static_cast<char>(i % 2));
+        EXPECT_EQ(same[i], static_cast<short>(i));
+    }
+}
+
+TEST(StreamOut, UnalignedColumns) {
+    // Columns starting at different offsets within a store width have
+    // their edges, at different rows, written with regular stores.
+    std::vector<int> x(600);
+    std::iota(x.begin(), x.end(), 0);
+    std::vector<int> a(604, -1);
+    std::vector<int> b(604, -1);
+    zip::slice<int*> ta{a.data() + 1, a.data() + 601};
+    zip::slice<int*> tb{b.data() + 3, b.data() + 603};
+    zip::assign(zip::stream_out(ta, tb),
+                zip::expr(x)([](int v) { return std::tuple{v, -v}; }));
+    EXPECT_EQ(a.front(), -1);
+    EXPECT_EQ(a.back(), -1);
+    EXPECT_EQ(b[2], -1);
+    EXPECT_EQ(b[603], -1);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        EXPECT_EQ(ta[static_cast<std::ptrdiff_t>(i)], static_cast<int>(i));
+        EXPECT_EQ(tb[static_cast<std::ptrdiff_t>(i)], -static_cast<int>(i));
+    }
+}
+
+TEST(StreamOut, ShortestSequence) {
+    std::vector<int> x{1, 2, 3, 4, 5};
+    std::vector<int> a(3, 0);
+    std::vector<int> b(10, 0);
+    zip::assign(zip::stream_out(a, b), zip::expr(x, x));
+    EXPECT_THAT(a, testing::ElementsAre(1, 2, 3));
+    EXPECT_THAT(b, testing::ElementsAre(1, 2, 3, 0, 0, 0, 0, 0, 0, 0));
+
+    std::vector<int> c(8, 0);
+    zip::assign(zip::stream_out(c), x);
+    EXPECT_THAT(c, testing::ElementsAre(1, 2, 3, 4, 5, 0, 0, 0));
+}
+
+TEST(StreamOut, NotTriviallyCopyable) {
+    std::vector<int> x{1, 2, 3};
+    std::vector<std::string> out(3);
+    zip::assign(zip::stream_out(out), zip::expr(x)([](int v) {
+                    return std::string(static_cast<std::size_t>(v), 'z');
+                }));
+    EXPECT_THAT(out, testing::ElementsAre("z", "zz", "zzz"));
+}
@@ -0,0 +1,108 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zip.h>
+#include <zip/stream.h>
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// The values read from a stream, as a sequence of input iterators.
+template <typename T>
+struct istream_range {
+    std::istream_iterator<T> begin() const { return std::istream_iterator<T>{*in}; }
+    std::istream_iterator<T> end() const { return {}; }
+    std::istream* in;
+};
+
+}  // namespace
+
+TEST(Stream, InputIterators) {
+    std::istringstream ids{"1 2 3 4 5 6 7"};
+    std::istringstream weights{"0.5 1.5 2.5 3.5 4.5 5.5 6.5"};
+    auto s = zip::stream(3, istream_range<int>{&ids}, istream_range<double>{&weights});
+
+    using iterator_category =
+        std::iterator_traits<decltype(s.begin())>::iterator_category;
+    static_assert(std::is_same_v<iterator_category, std::input_iterator_tag>,
+                  "streams are single-pass");
+    std::vector<std::size_t> sizes;
+    std::vector<std::tuple<int, double>> rows;
+    for (auto&& block : s) {
+        static_assert(zip::is_offset_iterator_v<decltype(block.begin())>,
+                      "blocks are contiguous");
+        sizes.push_back(block.size());
+        for (auto&& [id, weight] : block) {
+            rows.emplace_back(id, weight);
+        }
+    }
+    EXPECT_THAT(sizes, testing::ElementsAre(3u, 3u, 1u));
+    EXPECT_THAT(rows, testing::ElementsAre(std::tuple{1, 0.5}, std::tuple{2, 1.5},
+                                           std::tuple{3, 2.5}, std::tuple{4, 3.5},
+                                           std::tuple{5, 4.5}, std::tuple{6, 5.5},
+                                           std::tuple{7, 6.5}));
+}
+
+TEST(Stream, ShortestSource) {
+    std::istringstream words{"a b c d e"};
+    std::list<int> numbers{1, 2, 3};
+    std::vector<std::tuple<std::string, int>> rows;
+    for (auto&& block : zip::stream(2, istream_range<std::string>{&words}, numbers)) {
+        for (auto&& [word, number] : block) {
+            rows.emplace_back(word, number);
+        }
+    }
+    EXPECT_THAT(rows, testing::ElementsAre(std::tuple{"a", 1}, std::tuple{"b", 2},
+                                           std::tuple{"c", 3}));
+    // The stream stopped with the list: the only word read past the
+    // last row is "d", fetched ahead by the istream_iterator.
+    std::string rest;
+    words >> rest;
+    EXPECT_EQ(rest, "e");
+}
+
+TEST(Stream, Empty) {
+    std::istringstream empty;
+    std::vector<int> values{1, 2, 3};
+    auto s = zip::stream(4, istream_range<int>{&empty}, values);
+    EXPECT_EQ(s.begin(), s.end());
+}
+
+TEST(Stream, ExactBlocks) {
+    std::vector<int> values(8);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i);
+    }
+    std::size_t blocks = 0;
+    int sum = 0;
+    for (auto&& block : zip::stream(4, values)) {
+        EXPECT_EQ(block.size(), 4);
+        for (auto&& [value] : block) {
+            sum += value;
+        }
+        ++blocks;
+    }
+    EXPECT_EQ(blocks, 2);
+    EXPECT_EQ(sum, 28);
+}
+
+TEST(Stream, WritableBlocks) {
+    std::istringstream in{"1 2 3 4 5"};
+    std::vector<int> out;
+    for (auto&& block : zip::stream(2, istream_range<int>{&in})) {
+        for (auto&& [value] : block) {
+            value *= 10;
+        }
+        for (auto&& [value] : block) {
+            out.push_back(value);
+        }
+    }
+    EXPECT_THAT(out, testing::ElementsAre(10, 20, 30, 40, 50));
+}
@@ -4,10 +4,12 @@
 
 #include <algorithm>
 #include <array>
+#include <deque>
 #include <forward_list>
 #include <iterator>
 #include <limits>
 #include <list>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -50,7 +52,7 @@ TEST(Zip, IteratorCategoryForward) {
 TEST(Zip, IteratorCategoryRandomAccess) {
     std::array<int, 10> a;
     std::vector<long long> b;
-    std::array<signed char, 10> c;
+    std::deque<signed char> c;
     int d[20];
     auto deduced = zip::zip(a, b, c, d);
     EXPECT_TRUE((std::is_same_v<decltype(deduced)::iterator_category,
@@ -60,6 +62,80 @@ TEST(Zip, IteratorCategoryRandomAccess) {
                                 std::random_access_iterator_tag>));
 }
 
+TEST(Zip, IteratorCategoryContiguous) {
+    std::array<int, 10> a;
+    std::vector<long long> b;
+    std::array<signed char, 10> c;
+    int d[20];
+    auto deduced = zip::zip(a, b, c, d);
+    EXPECT_TRUE((std::is_same_v<decltype(deduced)::iterator_category,
+                                zip::offset_iterator_tag>));
+    // Contiguous sequences are walked via plain pointers
+    EXPECT_TRUE(
+        (std::is_same_v<decltype(deduced)::iterator,
+                        zip::offset_iterator<int*, long long*, signed char*, int*>>));
+    EXPECT_TRUE(
+        (std::is_same_v<decltype(deduced)::const_iterator,
+                        zip::offset_iterator<const int*, const long long*,
+                                             const signed char*, const int*>>));
+    // ...the very iterators an explicit offset_iterator_tag asks for
+    auto offset = zip::zip(zip::offset_iterator_tag{}, a, b, c, d);
+    EXPECT_TRUE((std::is_same_v<decltype(deduced), decltype(offset)>));
+    auto requested = zip::zip(std::random_access_iterator_tag{}, a, b, c, d);
+    EXPECT_TRUE((std::is_same_v<decltype(requested)::iterator_category,
+                                std::random_access_iterator_tag>));
+}
+
+TEST(Zip, IsContiguousSequence) {
+    EXPECT_TRUE((zip::is_contiguous_sequence_v<int[3]>));
+    EXPECT_TRUE((zip::is_contiguous_sequence_v<std::array<int, 3>>));
+    EXPECT_TRUE((zip::is_contiguous_sequence_v<const std::vector<int>>));
+    EXPECT_FALSE((zip::is_contiguous_sequence_v<std::vector<bool>>));
+    EXPECT_FALSE((zip::is_contiguous_sequence_v<std::deque<int>>));
+    EXPECT_FALSE((zip::is_contiguous_sequence_v<std::list<int>>));
+}
+
+TEST(Zip, ShortestSequence) {
+    std::vector<int> a{0, 1, 2, 3, 4};
+    std::vector<int> b{0, 1, 2};
+    auto z = zip::zip(a, b);
+    EXPECT_EQ(z.size(), 3);
+    EXPECT_EQ(std::end(z) - std::begin(z), 3);
+    EXPECT_EQ(z.cend() - z.cbegin(), 3);
+    EXPECT_EQ(std::distance(std::begin(z), std::end(z)), 3);
+    for (auto&& [aa, bb] : z) {
+        aa = -1;
+        bb = -1;
+    }
+    EXPECT_EQ(a, (std::vector<int>{-1, -1, -1, 3, 4}));
+    EXPECT_THAT(b, Each(-1));
+}
+
+TEST(Zip, Lockstep) {
+    std::deque<int> a{0, 1, 2, 3, 4};
+    std::vector<long long> b{0, 1, 2};
+    std::deque<signed char> c{0, 1, 2, 3};
+    auto z = zip::zip(a, b, c);
+    EXPECT_TRUE(
+        (std::is_same_v<decltype(z)::iterator,
+                        zip::lockstep_iterator<std::deque<int>::iterator,
+                                               std::vector<long long>::iterator,
+                                               std::deque<signed char>::iterator>>));
+    EXPECT_EQ(z.size(), 3);
+    EXPECT_EQ(std::end(z) - std::begin(z), 3);
+    EXPECT_EQ(z.cend() - z.cbegin(), 3);
+    EXPECT_LT(std::begin(z), std::end(z));
+    EXPECT_EQ(std::begin(z) + 3, std::end(z));
+    for (auto&& [aa, bb, cc] : z) {
+        aa = -1;
+        bb = -1;
+        cc = -1;
+    }
+    EXPECT_EQ(a, (std::deque<int>{-1, -1, -1, 3, 4}));
+    EXPECT_THAT(b, Each(-1));
+    EXPECT_EQ(c, (std::deque<signed char>{-1, -1, -1, 3}));
+}
+
 TEST(Zip, IteratorCategoryOffset) {
     std::array<int, 10> a;
     std::vector<long long> b;
@@ -93,6 +169,358 @@ TEST(Zip, RangeBasedForLoop) {
     // 9}));
 }
 
+TEST(Zip, ProxyReference) {
+    std::vector<int> a{1, 2};
+    std::vector<std::string> b{"one", "two"};
+    auto z = zip::zip(a, b);
+    // Copies of a reference refer to the same elements
+    auto ref = *std::begin(z);
+    std::get<0>(ref) = 10;
+    EXPECT_EQ(a[0], 10);
+    // Assignments write through, copying from lvalues...
+    auto second = *(std::begin(z) + 1);
+    *std::begin(z) = second;
+    EXPECT_EQ(a, (std::vector<int>{2, 2}));
+    EXPECT_EQ(b, (std::vector<std::string>{"two", "two"}));
+    // ...and from rvalues too, just like std::tuple<T&...>
+    b[1] = "four";
+    *std::begin(z) = std::move(second);
+    EXPECT_EQ(b, (std::vector<std::string>{"four", "four"}));
+    b[1] = "two";
+    // Values are materialised copies
+    decltype(z)::iterator::value_type value = ref;
+    std::get<1>(value) = "three";
+    EXPECT_EQ(b[0], "four");
+    *std::begin(z) = std::move(value);
+    EXPECT_EQ(b[0], "three");
+    // Swapping temporaries swaps the referred elements
+    swap(*std::begin(z), *(std::begin(z) + 1));
+    EXPECT_EQ(b, (std::vector<std::string>{"two", "three"}));
+}
+
+TEST(Zip, StdCopyKeepsSources) {
+    std::vector<int> a{1, 2, 3};
+    std::vector<std::string> b{"one", "two", "three"};
+    std::vector<int> c(3);
+    std::vector<std::string> d(3);
+    auto in = zip::zip(a, b);
+    auto out = zip::zip(c, d);
+    std::copy(std::begin(in), std::end(in), std::begin(out));
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(d, (std::vector<std::string>{"one", "two", "three"}));
+    EXPECT_EQ(b, (std::vector<std::string>{"one", "two", "three"}));
+
+    std::vector<int> e(3);
+    std::vector<std::string> f(3);
+    auto selected = zip::zip(e, f);
+    auto last = std::copy_if(std::begin(in), std::end(in), std::begin(selected),
+                             [](auto&& row) { return std::get<0>(row) != 2; });
+    EXPECT_EQ(last - std::begin(selected), 2);
+    EXPECT_EQ(f, (std::vector<std::string>{"one", "three", ""}));
+    EXPECT_EQ(b, (std::vector<std::string>{"one", "two", "three"}));
+}
+
+TEST(Zip, Enumerate) {
+    std::vector<int> a{10, 11, 12, 13};
+    std::list<int> b{0, 0, 0};
+
+    auto z = zip::enumerate(a);
+    EXPECT_TRUE(zip::is_offset_iterator_v<decltype(std::begin(z))>);
+    EXPECT_EQ(z.size(), 4);
+    for (auto&& [i, x] : z) {
+        EXPECT_EQ(static_cast<int>(i) + 10, x);
+    }
+    EXPECT_EQ(std::get<0>(z[3]), 3);
+
+    for (auto&& [i, x, y] : zip::enumerate(a, b)) {
+        y = x * static_cast<int>(i);
+    }
+    EXPECT_EQ(b, (std::list<int>{0, 11, 24}));
+}
+
+TEST(Zip, CountingSequence) {
+    zip::counting_sequence<short> ids{-2, 3};
+    std::vector<double> a(8, 0.);
+    EXPECT_EQ(std::size(ids), 5);
+
+    auto z = zip::zip(ids, a);
+    EXPECT_EQ(z.size(), 5);
+    for (auto&& [id, x] : z) {
+        x = id;
+    }
+    EXPECT_EQ(a, (std::vector<double>{-2., -1., 0., 1., 2., 0., 0., 0.}));
+
+    // The index column is a read-only value, rows still are references
+    auto&& row = *std::begin(z);
+    EXPECT_TRUE((std::is_same_v<std::tuple_element_t<0, std::decay_t<decltype(row)>>,
+                                const short>));
+    EXPECT_TRUE((std::is_same_v<std::tuple_element_t<1, std::decay_t<decltype(row)>>,
+                                double&>));
+    EXPECT_EQ(std::get<0>(zip::value_tuple<short, double>{row}), -2);
+}
+
+TEST(Batches, Lanes) {
+    std::vector<int> a{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<long long> b{9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+
+    std::vector<std::size_t> sizes;
+    std::vector<int> lanes_a;
+    std::vector<long long> lanes_b;
+    for (auto&& value : zip::batches<4>(zip::zip(a, b))) {
+        auto&& [aa, bb] = value;
+        EXPECT_TRUE((std::is_same_v<std::remove_reference_t<decltype(aa)>,
+                                    std::array<int, 4>>));
+        EXPECT_TRUE((std::is_same_v<std::remove_reference_t<decltype(bb)>,
+                                    std::array<long long, 4>>));
+        sizes.push_back(value.size());
+        lanes_a.insert(std::end(lanes_a), std::begin(aa), std::end(aa));
+        lanes_b.insert(std::end(lanes_b), std::begin(bb), std::end(bb));
+    }
+
+    EXPECT_EQ(sizes, (std::vector<std::size_t>{4, 4, 2}));
+    // Tail lanes are value-initialised
+    EXPECT_EQ(lanes_a, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0}));
+    EXPECT_EQ(lanes_b, (std::vector<long long>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 0, 0}));
+}
+
+TEST(Batches, Mask) {
+    std::array<float, 6> a{};
+    auto z = zip::batches<4>(zip::zip(a));
+    auto it = std::begin(z);
+    EXPECT_EQ((*it).mask(), (std::array<bool, 4>{true, true, true, true}));
+    ++it;
+    EXPECT_EQ((*it).mask(), (std::array<bool, 4>{true, true, false, false}));
+    EXPECT_TRUE((*it).active(1));
+    EXPECT_FALSE((*it).active(2));
+    ++it;
+    EXPECT_EQ(it, std::end(z));
+}
+
+TEST(Batches, ShortestSequence) {
+    std::vector<int> a(7, 1);
+    std::vector<int> b(5, 2);
+    std::size_t count = 0;
+    for (auto&& value : zip::batches<2>(zip::zip(a, b))) {
+        count += value.size();
+    }
+    EXPECT_EQ(count, 5);
+}
+
+TEST(Batches, EmptyIterationSpace) {
+    std::vector<int> a;
+    auto z = zip::batches<8>(zip::zip(zip::offset_iterator_tag{}, a));
+    EXPECT_EQ(std::begin(z), std::end(z));
+}
+
+TEST(Chunks, Rows) {
+    std::vector<int> a{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<long long> b{9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+    auto z = zip::chunks(zip::zip(a, b), 4);
+    EXPECT_EQ(std::size(z), 3);
+
+    std::vector<std::size_t> sizes;
+    std::vector<int> rows;
+    for (auto&& chunk : z) {
+        EXPECT_TRUE((zip::is_offset_iterator_v<decltype(std::begin(chunk))>));
+        sizes.push_back(std::size(chunk));
+        for (auto&& [x, y] : chunk) {
+            EXPECT_EQ(x + y, 9);
+            rows.push_back(x);
+        }
+    }
+    EXPECT_EQ(sizes, (std::vector<std::size_t>{4, 4, 2}));
+    EXPECT_EQ(rows, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(Chunks, RandomAccess) {
+    std::deque<int> a{0, 1, 2, 3, 4, 5, 6};
+    std::vector<int> b{0, 1, 2, 3, 4, 5, 6, 7, 8};
+    auto z = zip::chunks(zip::zip(a, b), 3);
+    auto it = std::begin(z);
+    EXPECT_EQ(std::end(z) - it, 3);
+    EXPECT_EQ(std::size(it[2]), 1);
+    EXPECT_EQ(std::get<0>(it[2][0]), 6);
+    it += 2;
+    --it;
+    EXPECT_EQ(std::get<1>((*it)[0]), 3);
+    EXPECT_TRUE(std::begin(z) < it);
+    EXPECT_EQ(it + 2, std::end(z));
+    EXPECT_EQ(2 + std::begin(z) - 1, it);
+}
+
+TEST(Chunks, MultiPass) {
+    std::vector<float> x(1000, 0.f);
+    std::vector<float> v(1000, 1.f);
+    for (auto&& chunk : zip::chunks(zip::zip(x, v), 64)) {
+        for (auto&& [xx, vv] : chunk) {
+            vv *= 2.f;
+        }
+        for (auto&& [xx, vv] : chunk) {
+            xx += vv;
+        }
+    }
+    ASSERT_THAT(x, Each(2.f));
+}
+
+TEST(Chunks, EmptyIterationSpace) {
+    std::vector<int> a;
+    auto z = zip::chunks(zip::zip(a), 16);
+    EXPECT_TRUE(z.empty());
+    EXPECT_EQ(std::begin(z), std::end(z));
+}
+
+TEST(Prefetched, Rows) {
+    std::vector<int> a{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::deque<long long> b{9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+    zip::counting_sequence<int> c{0, 10};
+    auto z = zip::prefetched<4>(zip::zip(a, b, c));
+    EXPECT_EQ(std::size(z), 10);
+    EXPECT_EQ(std::end(z) - std::begin(z), 10);
+    std::vector<int> rows;
+    for (auto&& [x, y, i] : z) {
+        EXPECT_EQ(x + y, 9);
+        EXPECT_EQ(x, i);
+        rows.push_back(x);
+    }
+    EXPECT_EQ(rows, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(std::get<1>(z[7]), 2);
+}
+
+TEST(Prefetched, Write) {
+    std::vector<float> x(1000, 1.f);
+    std::vector<float> y(1000, 0.f);
+    auto z = zip::prefetched<16, zip::prefetch_hint::write>(zip::zip(x, y));
+    for (auto&& [xx, yy] : z) {
+        yy = xx * 2.f;
+    }
+    const auto first = std::begin(z);
+    for (std::ptrdiff_t i = 0; i < 1000; i += 2) {
+        std::get<0>(first[i]) = 3.f;
+    }
+    ASSERT_THAT(y, Each(2.f));
+    EXPECT_EQ(std::count(x.begin(), x.end(), 3.f), 500);
+}
+
+TEST(Prefetched, Chunks) {
+    // Chunks start at a non-zero offset: rows are still those of the
+    // chunk, and the last ones are not prefetched past the sequence.
+    std::vector<int> a{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<int> rows;
+    for (auto&& chunk : zip::chunks(zip::zip(a), 4)) {
+        for (auto&& [x] : zip::prefetched<64>(chunk)) {
+            rows.push_back(x);
+        }
+    }
+    EXPECT_EQ(rows, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(Prefetched, EmptyIterationSpace) {
+    std::vector<int> a;
+    auto z = zip::prefetched<8>(zip::zip(a));
+    EXPECT_TRUE(z.empty());
+    EXPECT_EQ(std::begin(z), std::end(z));
+}
+
+TEST(NoAlias, OffsetView) {
+    std::vector<float> out(5);
+    const std::vector<float> x{1.f, 2.f, 3.f, 4.f, 5.f};
+    std::array<int, 3> y{7, 8, 9};
+    auto z = zip::zip(zip::no_alias, out, x, y);
+    using iterator = decltype(std::begin(z));
+    static_assert(
+        std::is_same_v<iterator, zip::no_alias_iterator<float*, const float*, int*>>,
+        "no_alias views walk pointers");
+    static_assert(zip::is_offset_iterator_v<iterator>, "no_alias views are offset views");
+    static_assert(zip::is_no_alias_iterator_v<iterator>);
+    EXPECT_EQ(z.size(), 3);
+    for (auto&& [o, a, b] : z) {
+        o = a * static_cast<float>(b);
+    }
+    EXPECT_THAT(out, testing::ElementsAre(7.f, 16.f, 27.f, 0.f, 0.f));
+    EXPECT_EQ(std::get<2>(std::begin(z)[1]), 8);
+}
+
+TEST(NoAlias, SharedReadOnlyColumns) {
+    // Columns that are only read may overlap, or be the same.
+    const std::vector<int> x{1, 2, 3, 4};
+    std::vector<int> out(3);
+    zip::slice<const int*> tail{x.data() + 1, x.data() + 4};
+    for (auto&& [o, a, b] : zip::zip(zip::no_alias, out, x, tail)) {
+        o = a + b;
+    }
+    EXPECT_THAT(out, testing::ElementsAre(3, 5, 7));
+    EXPECT_TRUE(zip::impl::disjoint_columns(3, out.data(), x.data(), x.data()));
+    EXPECT_FALSE(zip::impl::disjoint_columns(3, out.data(), out.data() + 2));
+    EXPECT_TRUE(zip::impl::disjoint_columns(2, out.data(), out.data() + 2));
+}
+
+namespace {
+
+struct particle {
+    float x;
+    int id;
+    double v;
+};
+
+}  // namespace
+
+TEST(Fields, ReadWrite) {
+    std::vector<particle> ps{{1.f, 3, 2.}, {2.f, 1, 3.}, {3.f, 2, 4.}};
+    auto z = zip::fields(ps, &particle::x, &particle::v);
+    EXPECT_EQ(z.size(), 3);
+    EXPECT_TRUE(zip::is_offset_iterator_v<decltype(std::begin(z))>);
+    for (auto&& [x, v] : z) {
+        x += static_cast<float>(v);
+    }
+    EXPECT_EQ(ps[0].x, 3.f);
+    EXPECT_EQ(ps[1].x, 5.f);
+    EXPECT_EQ(ps[2].x, 7.f);
+    EXPECT_EQ(ps[2].id, 2);
+
+    const auto& cps = ps;
+    auto&& [x, id] = zip::fields(cps, &particle::x, &particle::id)[1];
+    EXPECT_TRUE((std::is_same_v<decltype(x), const float&>));
+    EXPECT_EQ(id, 1);
+}
+
+TEST(Fields, CompileTimeMembers) {
+    std::vector<particle> ps{{1.f, 3, 2.}, {2.f, 1, 3.}};
+    auto z = zip::fields<&particle::v, &particle::id>(ps);
+    EXPECT_EQ(z.size(), 2);
+    for (auto&& [v, id] : z) {
+        v *= id;
+    }
+    EXPECT_EQ(ps[0].v, 6.);
+    EXPECT_EQ(ps[1].v, 3.);
+    EXPECT_EQ(std::get<1>(z[1]), 1);
+}
+
+TEST(Fields, StdSort) {
+    std::vector<particle> ps{{1.f, 3, 2.}, {2.f, 1, 3.}, {3.f, 2, 4.}};
+    auto z = zip::fields(ps, &particle::id, &particle::x);
+    std::sort(std::begin(z), std::end(z),
+              [](auto&& lhs, auto&& rhs) { return std::get<0>(lhs) < std::get<0>(rhs); });
+    // Only the zipped members move
+    EXPECT_EQ(ps[0].id, 1);
+    EXPECT_EQ(ps[0].x, 2.f);
+    EXPECT_EQ(ps[0].v, 2.);
+    EXPECT_EQ(ps[2].id, 3);
+    EXPECT_EQ(ps[2].x, 1.f);
+    EXPECT_EQ(ps[2].v, 4.);
+}
+
+TEST(Fields, Chunks) {
+    std::array<particle, 10> ps{};
+    std::size_t count = 0;
+    for (auto&& chunk : zip::chunks(zip::fields(ps, &particle::id), 4)) {
+        for (auto&& [id] : chunk) {
+            id = static_cast<int>(count++);
+        }
+    }
+    EXPECT_EQ(count, 10);
+    EXPECT_EQ(ps[9].id, 9);
+}
+
 // TODO
 // Add tests for iterator concept constraints, e.g.:
 // LegacyRandomAccessIterator =